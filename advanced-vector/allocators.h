@@ -0,0 +1,839 @@
+#pragma once
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#if defined(__linux__)
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// ,      ALIGNMENT  (,  - 
+//    ),     T .  
+//       ,      -
+template <typename T, size_t ALIGNMENT>
+class AlignedAllocator {
+    static_assert((ALIGNMENT & (ALIGNMENT - 1)) == 0, "ALIGNMENT must be a power of two");
+    static_assert(ALIGNMENT >= alignof(T), "ALIGNMENT must not be weaker than alignof(T)");
+
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    // allocator_traits       
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, std::max(ALIGNMENT, alignof(U))>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template <typename U, size_t OTHER_ALIGNMENT>
+    AlignedAllocator(const AlignedAllocator<U, OTHER_ALIGNMENT>& /*other*/) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(operator new(n * sizeof(T), std::align_val_t{ ALIGNMENT }));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        operator delete(p, n * sizeof(T), std::align_val_t{ ALIGNMENT });
+    }
+
+    template <typename U, size_t OTHER_ALIGNMENT>
+    bool operator==(const AlignedAllocator<U, OTHER_ALIGNMENT>& /*other*/) const noexcept {
+        return true;
+    }
+
+    template <typename U, size_t OTHER_ALIGNMENT>
+    bool operator!=(const AlignedAllocator<U, OTHER_ALIGNMENT>& /*other*/) const noexcept {
+        return false;
+    }
+};
+
+// -   x86-64  ARM
+inline constexpr size_t CACHE_LINE_SIZE = 64;
+
+// :   " "       .
+//   ,      ,
+//         (,   )
+class Arena {
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    explicit Arena(size_t block_size = DEFAULT_BLOCK_SIZE) noexcept
+        : block_size_(block_size) {
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    ~Arena() {
+        Release();
+    }
+
+    void* Allocate(size_t bytes, size_t alignment) {
+        char* result = AlignUp(current_, alignment);
+        if (current_ == nullptr || result > end_ || static_cast<size_t>(end_ - result) < bytes) {
+            AddBlock(bytes + alignment);
+            result = AlignUp(current_, alignment);
+        }
+        current_ = result + bytes;
+        bytes_allocated_ += bytes;
+        return result;
+    }
+
+    //       ptr  old_bytes  new_bytes ,
+    //        
+    bool TryExpand(void* ptr, size_t old_bytes, size_t new_bytes) noexcept {
+        char* begin = static_cast<char*>(ptr);
+        if (begin + old_bytes != current_ || static_cast<size_t>(end_ - begin) < new_bytes) {
+            return false;
+        }
+        current_ = begin + new_bytes;
+        bytes_allocated_ += new_bytes - old_bytes;
+        return true;
+    }
+
+    //    . ,  ,  
+    void Release() noexcept {
+        while (head_ != nullptr) {
+            Block* next = head_->next;
+            operator delete(head_);
+            head_ = next;
+        }
+        current_ = nullptr;
+        end_ = nullptr;
+        bytes_allocated_ = 0;
+    }
+
+    size_t BytesAllocated() const noexcept {
+        return bytes_allocated_;
+    }
+
+private:
+    struct Block {
+        Block* next;
+    };
+
+    static char* AlignUp(char* ptr, size_t alignment) noexcept {
+        const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+        return reinterpret_cast<char*>((address + alignment - 1) & ~(std::uintptr_t{ alignment } - 1));
+    }
+
+    void AddBlock(size_t min_bytes) {
+        const size_t size = std::max(block_size_, min_bytes + sizeof(Block));
+        auto* block = static_cast<Block*>(operator new(size));
+        block->next = head_;
+        head_ = block;
+        current_ = reinterpret_cast<char*>(block + 1);
+        end_ = reinterpret_cast<char*>(block) + size;
+    }
+
+    size_t block_size_;
+    Block* head_ = nullptr;
+    char* current_ = nullptr;
+    char* end_ = nullptr;
+    size_t bytes_allocated_ = 0;
+};
+
+// ,    .       :
+//  ,         
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+    using is_always_equal = std::false_type;
+
+    explicit ArenaAllocator(Arena& arena) noexcept
+        : arena_(&arena) {
+    }
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+        : arena_(&other.GetArena()) {
+    }
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(arena_->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* /*p*/, size_t /*n*/) noexcept {
+    }
+
+    bool expand(T* p, size_t old_n, size_t new_n) noexcept {
+        return arena_->TryExpand(p, old_n * sizeof(T), new_n * sizeof(T));
+    }
+
+    Arena& GetArena() const noexcept {
+        return *arena_;
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const noexcept {
+        return arena_ == &other.GetArena();
+    }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const noexcept {
+        return !(*this == other);
+    }
+
+private:
+    Arena* arena_;
+};
+
+//   malloc/free.  reallocate,    
+//    realloc:     ,    glibc
+//   mremap,   
+template <typename T>
+class MallocAllocator {
+    static_assert(alignof(T) <= alignof(std::max_align_t), "malloc does not support over-aligned types");
+
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    MallocAllocator() noexcept = default;
+
+    template <typename U>
+    MallocAllocator(const MallocAllocator<U>& /*other*/) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(CheckResult(std::malloc(Bytes(n))));
+    }
+
+    void deallocate(T* p, size_t /*n*/) noexcept {
+        std::free(static_cast<void*>(p));
+    }
+
+    T* reallocate(T* p, size_t /*old_n*/, size_t new_n) {
+        return static_cast<T*>(CheckResult(std::realloc(static_cast<void*>(p), Bytes(new_n))));
+    }
+
+    template <typename U>
+    bool operator==(const MallocAllocator<U>& /*other*/) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const MallocAllocator<U>& /*other*/) const noexcept {
+        return false;
+    }
+
+private:
+    static size_t Bytes(size_t n) {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return n * sizeof(T);
+    }
+
+    static void* CheckResult(void* p) {
+        if (p == nullptr) {
+            throw std::bad_alloc();
+        }
+        return p;
+    }
+};
+
+//    -   MIN_CLASS_SIZE  MAX_CLASS_SIZE .
+//            
+//   .   MAX_CLASS_SIZE   operator new
+class Pool {
+public:
+    static constexpr size_t MIN_CLASS_SIZE = 16;
+    static constexpr size_t MAX_CLASS_SIZE = 4096;
+    static constexpr size_t SLAB_SIZE = 64 * 1024;
+
+    Pool() = default;
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+
+    ~Pool() {
+        while (slabs_ != nullptr) {
+            Node* next = slabs_->next;
+            operator delete(slabs_);
+            slabs_ = next;
+        }
+    }
+
+    void* Allocate(size_t bytes, size_t alignment) {
+        if (bytes > MAX_CLASS_SIZE || alignment > alignof(std::max_align_t)) {
+            return operator new(bytes, std::align_val_t{ alignment });
+        }
+        const size_t index = ClassIndex(bytes);
+        if (free_lists_[index] == nullptr) {
+            Refill(index);
+        }
+        Node* node = free_lists_[index];
+        free_lists_[index] = node->next;
+        return node;
+    }
+
+    void Deallocate(void* ptr, size_t bytes, size_t alignment) noexcept {
+        if (bytes > MAX_CLASS_SIZE || alignment > alignof(std::max_align_t)) {
+            operator delete(ptr, std::align_val_t{ alignment });
+            return;
+        }
+        const size_t index = ClassIndex(bytes);
+        auto* node = static_cast<Node*>(ptr);
+        node->next = free_lists_[index];
+        free_lists_[index] = node;
+    }
+
+    //  ,        bytes 
+    static constexpr size_t SizeClass(size_t bytes) noexcept {
+        size_t size = MIN_CLASS_SIZE;
+        while (size < bytes) {
+            size *= 2;
+        }
+        return size;
+    }
+
+private:
+    struct Node {
+        Node* next;
+    };
+
+    static constexpr size_t NUM_CLASSES = 9;  // 16, 32, ..., 4096
+    static_assert(MIN_CLASS_SIZE << (NUM_CLASSES - 1) == MAX_CLASS_SIZE);
+
+    static size_t ClassIndex(size_t bytes) noexcept {
+        size_t index = 0;
+        for (size_t size = MIN_CLASS_SIZE; size < bytes; size *= 2) {
+            ++index;
+        }
+        return index;
+    }
+
+    //       index.        
+    void Refill(size_t index) {
+        const size_t block_size = MIN_CLASS_SIZE << index;
+        auto* slab = static_cast<char*>(operator new(SLAB_SIZE));
+        auto* header = reinterpret_cast<Node*>(slab);
+        header->next = slabs_;
+        slabs_ = header;
+        for (size_t offset = std::max(block_size, sizeof(Node)); offset + block_size <= SLAB_SIZE; offset += block_size) {
+            auto* node = reinterpret_cast<Node*>(slab + offset);
+            node->next = free_lists_[index];
+            free_lists_[index] = node;
+        }
+    }
+
+    Node* free_lists_[NUM_CLASSES] = {};
+    Node* slabs_ = nullptr;
+};
+
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+    using is_always_equal = std::false_type;
+
+    explicit PoolAllocator(Pool& pool) noexcept
+        : pool_(&pool) {
+    }
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) noexcept
+        : pool_(&other.GetPool()) {
+    }
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(pool_->Allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        pool_->Deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    Pool& GetPool() const noexcept {
+        return *pool_;
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>& other) const noexcept {
+        return pool_ == &other.GetPool();
+    }
+
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>& other) const noexcept {
+        return !(*this == other);
+    }
+
+private:
+    Pool* pool_;
+};
+
+//  LargePageAllocator
+struct LargePageOptions {
+    enum class HugePages {
+        NONE,         //  
+        TRANSPARENT,  // madvise(MADV_HUGEPAGE):      
+        EXPLICIT,     // MAP_HUGETLB    ,    - TRANSPARENT
+    };
+
+    enum class Numa {
+        DEFAULT,     //     ,    
+        BIND,        //     nodes
+        INTERLEAVE,  //      nodes,     
+    };
+
+    static constexpr size_t DEFAULT_MMAP_THRESHOLD = 1 << 20;
+
+    size_t mmap_threshold = DEFAULT_MMAP_THRESHOLD;  //      
+    HugePages huge_pages = HugePages::TRANSPARENT;
+    Numa numa = Numa::DEFAULT;
+    unsigned long nodes = 0;  //    NUMA  BIND  INTERLEAVE
+
+    bool operator==(const LargePageOptions& other) const noexcept {
+        return mmap_threshold == other.mmap_threshold && huge_pages == other.huge_pages && numa == other.numa
+            && nodes == other.nodes;
+    }
+};
+
+//    :   mmap_threshold     mmap
+//       NUMA,    TLB  .
+//       ,     .
+//         mremap  .
+//  madvise  mbind :    .  Linux    
+template <typename T>
+class LargePageAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+    using is_always_equal = std::false_type;
+
+    static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    LargePageAllocator() noexcept = default;
+
+    explicit LargePageAllocator(const LargePageOptions& options) noexcept
+        : options_(options) {
+    }
+
+    template <typename U>
+    LargePageAllocator(const LargePageAllocator<U>& other) noexcept
+        : options_(other.GetOptions()) {
+    }
+
+    T* allocate(size_t n) {
+        const size_t bytes = Bytes(n);
+        if (!IsMapped(bytes)) {
+            return std::allocator<T>().allocate(n);
+        }
+        return static_cast<T*>(Map(bytes));
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        const size_t bytes = n * sizeof(T);
+        if (!IsMapped(bytes)) {
+            std::allocator<T>().deallocate(p, n);
+            return;
+        }
+        Unmap(p, bytes);
+    }
+
+    //     mremap,    memcpy
+    T* reallocate(T* p, size_t old_n, size_t new_n) {
+        const size_t old_bytes = old_n * sizeof(T);
+        const size_t new_bytes = Bytes(new_n);
+#if defined(__linux__)
+        if (IsMapped(old_bytes) && IsMapped(new_bytes) && options_.huge_pages != LargePageOptions::HugePages::EXPLICIT) {
+            const size_t old_length = MappedLength(old_bytes);
+            const size_t new_length = MappedLength(new_bytes);
+            void* result = mremap(static_cast<void*>(p), old_length, new_length, MREMAP_MAYMOVE);
+            if (result == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            ApplyPolicy(result, new_length);
+            return static_cast<T*>(result);
+        }
+#endif
+        T* result = allocate(new_n);
+        std::memcpy(static_cast<void*>(result), static_cast<const void*>(p), std::min(old_bytes, new_bytes));
+        deallocate(p, old_n);
+        return result;
+    }
+
+    const LargePageOptions& GetOptions() const noexcept {
+        return options_;
+    }
+
+    template <typename U>
+    bool operator==(const LargePageAllocator<U>& other) const noexcept {
+        return options_ == other.GetOptions();
+    }
+
+    template <typename U>
+    bool operator!=(const LargePageAllocator<U>& other) const noexcept {
+        return !(*this == other);
+    }
+
+private:
+    static size_t Bytes(size_t n) {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return n * sizeof(T);
+    }
+
+    bool IsMapped(size_t bytes) const noexcept {
+#if defined(__linux__)
+        return bytes != 0 && bytes >= options_.mmap_threshold;
+#else
+        (void)bytes;
+        return false;
+#endif
+    }
+
+#if defined(__linux__)
+    //       ,  deallocate   ,
+    //   allocate,   MAP_HUGETLB  
+    size_t MappedLength(size_t bytes) const noexcept {
+        const size_t page = options_.huge_pages == LargePageOptions::HugePages::EXPLICIT
+            ? HUGE_PAGE_SIZE
+            : static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return (bytes + page - 1) / page * page;
+    }
+
+    void* Map(size_t bytes) const {
+        const size_t length = MappedLength(bytes);
+        void* p = MAP_FAILED;
+        if (options_.huge_pages == LargePageOptions::HugePages::EXPLICIT) {
+            p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        }
+        if (p == MAP_FAILED) {
+            p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+        }
+        ApplyPolicy(p, length);
+        return p;
+    }
+
+    void Unmap(void* p, size_t bytes) const noexcept {
+        munmap(p, MappedLength(bytes));
+    }
+
+    void ApplyPolicy(void* p, size_t length) const noexcept {
+        if (options_.huge_pages != LargePageOptions::HugePages::NONE) {
+            madvise(p, length, MADV_HUGEPAGE);
+        }
+        if (options_.numa != LargePageOptions::Numa::DEFAULT) {
+            const int mode = options_.numa == LargePageOptions::Numa::BIND ? MPOL_BIND : MPOL_INTERLEAVE;
+            const unsigned long nodes = options_.nodes;
+            //   maxnode       ,  +1,
+            //     
+            syscall(SYS_mbind, p, length, mode, &nodes, sizeof(nodes) * 8 + 1, 0);
+        }
+    }
+#else
+    void* Map(size_t /*bytes*/) const {
+        throw std::bad_alloc();
+    }
+
+    void Unmap(void* /*p*/, size_t /*bytes*/) const noexcept {
+    }
+#endif
+
+    LargePageOptions options_;
+};
+
+//           . ,
+//          ,  
+//    .    Limits;     .
+//            :
+//    AllocateLocal  DeallocateLocal    
+class BufferRecycler {
+public:
+    static constexpr size_t MIN_BUFFER_BYTES = 64;
+    static constexpr size_t MAX_BUFFER_BYTES = 1 << 20;  //  -   
+
+    struct Limits {
+        size_t max_buffer_bytes = MAX_BUFFER_BYTES / 4;  //   MAX_BUFFER_BYTES
+        size_t max_cached_bytes = 4 << 20;
+        size_t max_buffers_per_bucket = 16;
+    };
+
+    BufferRecycler() = default;
+    BufferRecycler(const BufferRecycler&) = delete;
+    BufferRecycler& operator=(const BufferRecycler&) = delete;
+
+    ~BufferRecycler() {
+        Trim();
+    }
+
+    //   ,    .     
+    static BufferRecycler& Local() {
+        BufferRecycler* recycler = TryLocal();
+        assert(recycler != nullptr && "BufferRecycler::Local() after thread teardown");
+        return *recycler;
+    }
+
+    //     nullptr,       
+    static BufferRecycler* TryLocal() {
+        //   ,      ,    
+        thread_local bool destroyed = false;
+        if (destroyed) {
+            return nullptr;
+        }
+        //    ,      
+        struct LocalRecycler : BufferRecycler {
+            ~LocalRecycler() {
+                destroyed = true;
+            }
+        };
+        thread_local LocalRecycler recycler;
+        return &recycler;
+    }
+
+    //       ,     -  .
+    //      ,    ,      
+    static void* AllocateLocal(size_t bytes) {
+        if (BufferRecycler* recycler = TryLocal()) {
+            return recycler->Allocate(bytes);
+        }
+        return operator new(BufferBytes(bytes));
+    }
+
+    static void DeallocateLocal(void* ptr, size_t bytes) noexcept {
+        if (BufferRecycler* recycler = TryLocal()) {
+            recycler->Deallocate(ptr, bytes);
+        }
+        else {
+            operator delete(ptr, BufferBytes(bytes));
+        }
+    }
+
+    //  ,       bytes 
+    static constexpr size_t BufferBytes(size_t bytes) noexcept {
+        if (bytes > MAX_BUFFER_BYTES) {
+            return bytes;
+        }
+        size_t size = MIN_BUFFER_BYTES;
+        while (size < bytes) {
+            size *= 2;
+        }
+        return size;
+    }
+
+    void* Allocate(size_t bytes) {
+        const size_t size = BufferBytes(bytes);
+        if (size <= MAX_BUFFER_BYTES) {
+            Bucket& bucket = buckets_[BucketIndex(size)];
+            if (bucket.head != nullptr) {
+                Node* node = bucket.head;
+                bucket.head = node->next;
+                --bucket.count;
+                cached_bytes_ -= size;
+                ++hits_;
+                return node;
+            }
+        }
+        ++misses_;
+        return operator new(size);
+    }
+
+    void Deallocate(void* ptr, size_t bytes) noexcept {
+        const size_t size = BufferBytes(bytes);
+        if (size <= std::min(limits_.max_buffer_bytes, MAX_BUFFER_BYTES)
+            && cached_bytes_ + size <= limits_.max_cached_bytes) {
+            Bucket& bucket = buckets_[BucketIndex(size)];
+            if (bucket.count < limits_.max_buffers_per_bucket) {
+                auto* node = static_cast<Node*>(ptr);
+                node->next = bucket.head;
+                bucket.head = node;
+                ++bucket.count;
+                cached_bytes_ += size;
+                return;
+            }
+        }
+        operator delete(ptr, size);
+    }
+
+    //      ;      
+    void SetLimits(const Limits& limits) noexcept {
+        limits_ = limits;
+    }
+
+    const Limits& GetLimits() const noexcept {
+        return limits_;
+    }
+
+    //      
+    void Trim() noexcept {
+        for (size_t index = 0; index < NUM_BUCKETS; ++index) {
+            Bucket& bucket = buckets_[index];
+            while (bucket.head != nullptr) {
+                Node* next = bucket.head->next;
+                operator delete(bucket.head, MIN_BUFFER_BYTES << index);
+                bucket.head = next;
+            }
+            bucket.count = 0;
+        }
+        cached_bytes_ = 0;
+    }
+
+    size_t CachedBytes() const noexcept {
+        return cached_bytes_;
+    }
+
+    //  ,      
+    size_t Hits() const noexcept {
+        return hits_;
+    }
+
+    size_t Misses() const noexcept {
+        return misses_;
+    }
+
+private:
+    struct Node {
+        Node* next;
+    };
+
+    struct Bucket {
+        Node* head = nullptr;
+        size_t count = 0;
+    };
+
+    static constexpr size_t NUM_BUCKETS = 15;  // 64, 128, ..., 1 
+    static_assert(MIN_BUFFER_BYTES << (NUM_BUCKETS - 1) == MAX_BUFFER_BYTES);
+
+    static size_t BucketIndex(size_t size) noexcept {
+        size_t index = 0;
+        while ((MIN_BUFFER_BYTES << index) < size) {
+            ++index;
+        }
+        return index;
+    }
+
+    Bucket buckets_[NUM_BUCKETS];
+    size_t cached_bytes_ = 0;
+    size_t hits_ = 0;
+    size_t misses_ = 0;
+    Limits limits_;
+};
+
+// ,    BufferRecycler ,    .
+// ,    ,      . 
+//   ,       operator new  
+template <typename T>
+class RecyclingAllocator {
+    static constexpr bool CACHED = alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    RecyclingAllocator() noexcept = default;
+
+    template <typename U>
+    RecyclingAllocator(const RecyclingAllocator<U>& /*other*/) noexcept {
+    }
+
+    T* allocate(size_t n) {
+        if (n > std::numeric_limits<size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        if constexpr (CACHED) {
+            return static_cast<T*>(BufferRecycler::AllocateLocal(n * sizeof(T)));
+        }
+        else {
+            return std::allocator<T>().allocate(n);
+        }
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        if constexpr (CACHED) {
+            BufferRecycler::DeallocateLocal(p, n * sizeof(T));
+        }
+        else {
+            std::allocator<T>().deallocate(p, n);
+        }
+    }
+
+    template <typename U>
+    bool operator==(const RecyclingAllocator<U>& /*other*/) const noexcept {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const RecyclingAllocator<U>& /*other*/) const noexcept {
+        return false;
+    }
+};
+
+//  ,     Vector::Adopt:   -,
+//    . .     ,  ,   
+// , - operator new.          
+template <typename T>
+class ExternalBufferAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    ExternalBufferAllocator() = default;
+
+    template <typename Deleter>
+    ExternalBufferAllocator(T* buffer, Deleter deleter)
+        : external_(std::make_shared<External>(External{ buffer, std::move(deleter) })) {
+    }
+
+    T* allocate(size_t n) {
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        if (external_ != nullptr && p == external_->buffer) {
+            //     operator new ,     
+            external_->buffer = nullptr;
+            external_->deleter(p);
+            return;
+        }
+        std::allocator<T>().deallocate(p, n);
+    }
+
+    bool operator==(const ExternalBufferAllocator& other) const noexcept {
+        return external_ == other.external_;
+    }
+
+    bool operator!=(const ExternalBufferAllocator& other) const noexcept {
+        return !(*this == other);
+    }
+
+private:
+    struct External {
+        T* buffer;
+        std::function<void(T*)> deleter;
+    };
+
+    std::shared_ptr<External> external_;
+};
@@ -0,0 +1,483 @@
+//  Vector  Google Benchmark.      Vector,   std::vector
+//     ,       :
+//   g++ -std=c++17 -O2 benchmark.cpp -lbenchmark -lpthread -o benchmark && ./benchmark
+#include "vector.h"
+#include "flat_map.h"
+#include "vector_algorithms.h"
+#include "vector_serialization.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <map>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+    //  :       
+    struct Heavy {
+        explicit Heavy(int id = 0)
+            : id(id)
+            , name(std::to_string(id)) {
+            payload.fill(static_cast<char>(id));
+        }
+
+        int id = 0;
+        std::string name;
+        std::array<char, 256> payload{};
+    };
+
+    template <typename T>
+    T MakeElement(size_t i);
+
+    template <>
+    int MakeElement<int>(size_t i) {
+        return static_cast<int>(i);
+    }
+
+    template <>
+    std::string MakeElement<std::string>(size_t i) {
+        //    ,    
+        return "element number " + std::to_string(i) + " of the benchmark";
+    }
+
+    template <>
+    float MakeElement<float>(size_t i) {
+        return static_cast<float>(i % 1000);
+    }
+
+    template <>
+    Heavy MakeElement<Heavy>(size_t i) {
+        return Heavy(static_cast<int>(i));
+    }
+
+    //    Vector  std::vector,         
+    template <typename T>
+    void PushBack(Vector<T>& v, const T& value) {
+        v.PushBack(value);
+    }
+    template <typename T>
+    void PushBack(std::vector<T>& v, const T& value) {
+        v.push_back(value);
+    }
+
+    template <typename T>
+    void EmplaceBack(Vector<T>& v, size_t i) {
+        v.EmplaceBack(MakeElement<T>(i));
+    }
+    template <typename T>
+    void EmplaceBack(std::vector<T>& v, size_t i) {
+        v.emplace_back(MakeElement<T>(i));
+    }
+
+    template <typename T>
+    void Reserve(Vector<T>& v, size_t capacity) {
+        v.Reserve(capacity);
+    }
+    template <typename T>
+    void Reserve(std::vector<T>& v, size_t capacity) {
+        v.reserve(capacity);
+    }
+
+    template <typename T>
+    void Resize(Vector<T>& v, size_t size) {
+        v.Resize(size);
+    }
+    template <typename T>
+    void Resize(std::vector<T>& v, size_t size) {
+        v.resize(size);
+    }
+
+    template <typename T>
+    void Insert(Vector<T>& v, size_t index, const T& value) {
+        v.Insert(v.cbegin() + index, value);
+    }
+    template <typename T>
+    void Insert(std::vector<T>& v, size_t index, const T& value) {
+        v.insert(v.cbegin() + index, value);
+    }
+
+    template <typename T>
+    void Erase(Vector<T>& v, size_t index) {
+        v.Erase(v.cbegin() + index);
+    }
+    template <typename T>
+    void Erase(std::vector<T>& v, size_t index) {
+        v.erase(v.cbegin() + index);
+    }
+
+    template <typename T>
+    size_t Size(const Vector<T>& v) {
+        return v.Size();
+    }
+    template <typename T>
+    size_t Size(const std::vector<T>& v) {
+        return v.size();
+    }
+
+    template <typename Container>
+    Container MakeFilled(size_t size) {
+        Container v;
+        Reserve(v, size);
+        for (size_t i = 0; i < size; ++i) {
+            EmplaceBack(v, i);
+        }
+        return v;
+    }
+
+    template <typename Container>
+    void BM_PushBack(benchmark::State& state) {
+        using T = typename Container::value_type;
+        const auto size = static_cast<size_t>(state.range(0));
+        const T value = MakeElement<T>(size);
+        for (auto _ : state) {
+            Container v;
+            for (size_t i = 0; i < size; ++i) {
+                PushBack(v, value);
+            }
+            benchmark::DoNotOptimize(v);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    template <typename Container>
+    void BM_EmplaceBack(benchmark::State& state) {
+        const auto size = static_cast<size_t>(state.range(0));
+        for (auto _ : state) {
+            Container v;
+            for (size_t i = 0; i < size; ++i) {
+                EmplaceBack(v, i);
+            }
+            benchmark::DoNotOptimize(v);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    //        
+    template <typename Container>
+    void BM_Reserve(benchmark::State& state) {
+        const auto size = static_cast<size_t>(state.range(0));
+        for (auto _ : state) {
+            state.PauseTiming();
+            Container v = MakeFilled<Container>(size);
+            state.ResumeTiming();
+            Reserve(v, size * 2);
+            benchmark::DoNotOptimize(v);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    template <typename Container>
+    void BM_Resize(benchmark::State& state) {
+        const auto size = static_cast<size_t>(state.range(0));
+        for (auto _ : state) {
+            Container v;
+            Resize(v, size);
+            benchmark::DoNotOptimize(v);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    enum class Position {
+        FRONT,
+        MIDDLE,
+        END,
+    };
+
+    size_t IndexFor(Position position, size_t size) {
+        switch (position) {
+        case Position::FRONT:
+            return 0;
+        case Position::MIDDLE:
+            return size / 2;
+        case Position::END:
+            break;
+        }
+        return size;
+    }
+
+    //  state.range(0)          
+    template <typename Container, Position position>
+    void BM_Insert(benchmark::State& state) {
+        using T = typename Container::value_type;
+        const auto size = static_cast<size_t>(state.range(0));
+        const T value = MakeElement<T>(size);
+        for (auto _ : state) {
+            state.PauseTiming();
+            Container v = MakeFilled<Container>(size);
+            state.ResumeTiming();
+            for (size_t i = 0; i < size; ++i) {
+                Insert(v, IndexFor(position, Size(v)), value);
+            }
+            benchmark::DoNotOptimize(v);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    //        
+    template <typename Container, Position position>
+    void BM_Erase(benchmark::State& state) {
+        const auto size = static_cast<size_t>(state.range(0));
+        for (auto _ : state) {
+            state.PauseTiming();
+            Container v = MakeFilled<Container>(size);
+            state.ResumeTiming();
+            while (Size(v) != 0) {
+                Erase(v, std::min(IndexFor(position, Size(v)), Size(v) - 1));
+            }
+            benchmark::DoNotOptimize(v);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    //    ,    (larger_destination)   
+    template <typename Container, bool larger_destination>
+    void BM_CopyAssign(benchmark::State& state) {
+        const auto size = static_cast<size_t>(state.range(0));
+        const Container source = MakeFilled<Container>(size);
+        for (auto _ : state) {
+            state.PauseTiming();
+            Container destination = MakeFilled<Container>(larger_destination ? size * 2 : size / 2);
+            state.ResumeTiming();
+            destination = source;
+            benchmark::DoNotOptimize(destination);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    template <typename Container>
+    void RegisterContainer(const std::string& prefix) {
+        const auto add = [&prefix](const std::string& name, auto* func, int64_t max_size) {
+            benchmark::RegisterBenchmark((name + "/" + prefix).c_str(), func)->RangeMultiplier(8)->Range(8, max_size);
+        };
+        constexpr int64_t LINEAR_MAX = 1 << 18;
+        constexpr int64_t QUADRATIC_MAX = 1 << 12;
+        add("PushBack", &BM_PushBack<Container>, LINEAR_MAX);
+        add("EmplaceBack", &BM_EmplaceBack<Container>, LINEAR_MAX);
+        add("Reserve", &BM_Reserve<Container>, LINEAR_MAX);
+        add("Resize", &BM_Resize<Container>, LINEAR_MAX);
+        add("InsertFront", &BM_Insert<Container, Position::FRONT>, QUADRATIC_MAX);
+        add("InsertMiddle", &BM_Insert<Container, Position::MIDDLE>, QUADRATIC_MAX);
+        add("InsertEnd", &BM_Insert<Container, Position::END>, LINEAR_MAX);
+        add("EraseFront", &BM_Erase<Container, Position::FRONT>, QUADRATIC_MAX);
+        add("EraseMiddle", &BM_Erase<Container, Position::MIDDLE>, QUADRATIC_MAX);
+        add("EraseEnd", &BM_Erase<Container, Position::END>, LINEAR_MAX);
+        add("CopyAssignIntoSmaller", &BM_CopyAssign<Container, false>, LINEAR_MAX);
+        add("CopyAssignIntoLarger", &BM_CopyAssign<Container, true>, LINEAR_MAX);
+    }
+
+    //   :    
+    template <typename T>
+    void BM_SimdSum(benchmark::State& state) {
+        const Vector<T> v = MakeFilled<Vector<T>>(static_cast<size_t>(state.range(0)));
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(Sum(v));
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T));
+    }
+
+    template <typename T>
+    void BM_StdAccumulate(benchmark::State& state) {
+        const Vector<T> v = MakeFilled<Vector<T>>(static_cast<size_t>(state.range(0)));
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(std::accumulate(v.begin(), v.end(), simd::SumType<T>{}));
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T));
+    }
+
+    template <typename T>
+    void BM_SimdFind(benchmark::State& state) {
+        const Vector<T> v = MakeFilled<Vector<T>>(static_cast<size_t>(state.range(0)));
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(Find(v, T(-1)));
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T));
+    }
+
+    template <typename T>
+    void BM_StdFind(benchmark::State& state) {
+        const Vector<T> v = MakeFilled<Vector<T>>(static_cast<size_t>(state.range(0)));
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(std::find(v.begin(), v.end(), T(-1)));
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T));
+    }
+
+    template <typename T>
+    void RegisterScan(const std::string& type_name) {
+        const auto add = [&type_name](const std::string& name, auto* func) {
+            benchmark::RegisterBenchmark((name + "/" + type_name).c_str(), func)->RangeMultiplier(64)->Range(64, 1 << 20);
+        };
+        add("SimdSum", &BM_SimdSum<T>);
+        add("StdAccumulate", &BM_StdAccumulate<T>);
+        add("SimdFind", &BM_SimdFind<T>);
+        add("StdFind", &BM_StdFind<T>);
+    }
+
+    //    :      Serialize/Deserialize
+    void BM_WritePerElement(benchmark::State& state) {
+        const Vector<int> v = MakeFilled<Vector<int>>(static_cast<size_t>(state.range(0)));
+        for (auto _ : state) {
+            std::ostringstream out;
+            const size_t size = v.Size();
+            out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+            for (size_t i = 0; i < v.Size(); ++i) {
+                out.write(reinterpret_cast<const char*>(&v[i]), sizeof(int));
+            }
+            benchmark::DoNotOptimize(out);
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(int));
+    }
+
+    void BM_Serialize(benchmark::State& state) {
+        const Vector<int> v = MakeFilled<Vector<int>>(static_cast<size_t>(state.range(0)));
+        for (auto _ : state) {
+            std::ostringstream out;
+            Serialize(out, v);
+            benchmark::DoNotOptimize(out);
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(int));
+    }
+
+    void BM_ReadPerElement(benchmark::State& state) {
+        std::ostringstream out;
+        const size_t size = static_cast<size_t>(state.range(0));
+        out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        for (const int value : MakeFilled<Vector<int>>(size)) {
+            out.write(reinterpret_cast<const char*>(&value), sizeof(int));
+        }
+        const std::string bytes = out.str();
+        for (auto _ : state) {
+            std::istringstream in(bytes);
+            size_t count = 0;
+            in.read(reinterpret_cast<char*>(&count), sizeof(count));
+            Vector<int> v;
+            for (size_t i = 0; i < count; ++i) {
+                int value = 0;
+                in.read(reinterpret_cast<char*>(&value), sizeof(int));
+                v.PushBack(value);
+            }
+            benchmark::DoNotOptimize(v);
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(int));
+    }
+
+    void BM_Deserialize(benchmark::State& state) {
+        std::ostringstream out;
+        Serialize(out, MakeFilled<Vector<int>>(static_cast<size_t>(state.range(0))));
+        const std::string bytes = out.str();
+        for (auto _ : state) {
+            std::istringstream in(bytes);
+            Vector<int> v;
+            Deserialize(in, v);
+            benchmark::DoNotOptimize(v);
+        }
+        state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(int));
+    }
+
+    void RegisterSerialization() {
+        for (const auto& [name, func] : { std::pair{ "WritePerElement", &BM_WritePerElement },
+                                          std::pair{ "Serialize", &BM_Serialize },
+                                          std::pair{ "ReadPerElement", &BM_ReadPerElement },
+                                          std::pair{ "Deserialize", &BM_Deserialize } }) {
+            benchmark::RegisterBenchmark((std::string(name) + "/int").c_str(), func)->RangeMultiplier(64)->Range(64, 1 << 20);
+        }
+    }
+
+    //   ,   : FlatMap  std::map
+    template <typename Map>
+    void BM_Lookup(benchmark::State& state) {
+        const auto size = static_cast<int>(state.range(0));
+        Map map;
+        for (int i = 0; i < size; ++i) {
+            map[i * 2] = i;
+        }
+        int key = 0;
+        for (auto _ : state) {
+            // ,    ,   
+            key = (key + 7919 * 2) % (size * 2);
+            if constexpr (std::is_same_v<Map, FlatMap<int, int>>) {
+                benchmark::DoNotOptimize(map.Find(key));
+            }
+            else {
+                benchmark::DoNotOptimize(map.find(key));
+            }
+        }
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void RegisterLookup() {
+        benchmark::RegisterBenchmark("Lookup/FlatMap<int,int>", &BM_Lookup<FlatMap<int, int>>)->RangeMultiplier(64)->Range(64, 1 << 20);
+        benchmark::RegisterBenchmark("Lookup/std::map<int,int>", &BM_Lookup<std::map<int, int>>)->RangeMultiplier(64)->Range(64, 1 << 20);
+    }
+
+    //    4      :  Reserve,
+    // ReserveAtLeast       
+    struct RowsTag {
+        static constexpr std::string_view NAME = "benchmark rows";
+    };
+
+    enum class ReserveMode {
+        EXACT,
+        AT_LEAST,
+        HINTED,
+    };
+
+    template <ReserveMode MODE>
+    void BM_ReserveLoop(benchmark::State& state) {
+        const auto size = static_cast<size_t>(state.range(0));
+        for (auto _ : state) {
+            using Stats = std::conditional_t<MODE == ReserveMode::HINTED, HintedStats<RowsTag>, NoStats>;
+            Vector<int, std::allocator<int>, DoublingGrowth, Stats> v;
+            while (v.Size() < size) {
+                if constexpr (MODE == ReserveMode::EXACT) {
+                    v.Reserve(v.Size() + 4);
+                }
+                else if constexpr (MODE == ReserveMode::AT_LEAST) {
+                    v.ReserveAtLeast(v.Size() + 4);
+                }
+                for (int i = 0; i < 4; ++i) {
+                    v.EmplaceBack(i);
+                }
+            }
+            benchmark::DoNotOptimize(v.Data());
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+
+    void RegisterReserve() {
+        benchmark::RegisterBenchmark("ReserveLoop/Exact", &BM_ReserveLoop<ReserveMode::EXACT>)->RangeMultiplier(8)->Range(64, 1 << 15);
+        benchmark::RegisterBenchmark("ReserveLoop/AtLeast", &BM_ReserveLoop<ReserveMode::AT_LEAST>)->RangeMultiplier(8)->Range(64, 1 << 15);
+        benchmark::RegisterBenchmark("ReserveLoop/Hinted", &BM_ReserveLoop<ReserveMode::HINTED>)->RangeMultiplier(8)->Range(64, 1 << 15);
+    }
+
+    template <typename T>
+    void RegisterElement(const std::string& type_name) {
+        RegisterContainer<Vector<T>>("Vector<" + type_name + ">");
+        RegisterContainer<std::vector<T>>("std::vector<" + type_name + ">");
+    }
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    RegisterElement<int>("int");
+    RegisterElement<std::string>("string");
+    RegisterElement<Heavy>("Heavy");
+    RegisterScan<int>("int");
+    RegisterScan<float>("float");
+    RegisterSerialization();
+    RegisterLookup();
+    RegisterReserve();
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+}
@@ -0,0 +1,178 @@
+#pragma once
+#include "vector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+//          .
+//     ,      :
+//  k  FIRST_SEGMENT_SIZE * 2^k     , 
+//     .   -  ,
+//   :   ,       .
+//       ,     
+template <typename T, size_t FIRST_SEGMENT_SIZE = 64>
+class ConcurrentVector {
+    static_assert(FIRST_SEGMENT_SIZE > 0 && (FIRST_SEGMENT_SIZE & (FIRST_SEGMENT_SIZE - 1)) == 0,
+                  "FIRST_SEGMENT_SIZE must be a power of two");
+
+    //      
+    struct Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+        std::atomic<bool> published{ false };
+
+        T* Get() noexcept {
+            return std::launder(reinterpret_cast<T*>(storage));
+        }
+    };
+
+    static constexpr size_t NUM_SEGMENTS = 64;
+
+public:
+    ConcurrentVector() = default;
+    ConcurrentVector(const ConcurrentVector&) = delete;
+    ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+    ~ConcurrentVector() {
+        Clear();
+    }
+
+    //          . 
+    //     .    , 
+    //   :    Size(),   
+    template <typename... Args>
+    size_t EmplaceBack(Args&&... args) {
+        const size_t index = size_.fetch_add(1, std::memory_order_relaxed);
+        const auto [segment, offset] = Locate(index);
+        Slot& slot = AcquireSegment(segment)[offset];
+        new (slot.storage) T(std::forward<Args>(args)...);
+        slot.published.store(true, std::memory_order_release);
+        return index;
+    }
+
+    size_t PushBack(const T& value) {
+        return EmplaceBack(value);
+    }
+
+    size_t PushBack(T&& value) {
+        return EmplaceBack(std::move(value));
+    }
+
+    //   .        
+    size_t Size() const noexcept {
+        return size_.load(std::memory_order_acquire);
+    }
+
+    //  index,    ,  nullptr
+    const T* TryGet(size_t index) const noexcept {
+        const auto [segment, offset] = Locate(index);
+        Slot* slots = segments_[segment].load(std::memory_order_acquire);
+        if (slots == nullptr || !slots[offset].published.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return slots[offset].Get();
+    }
+
+    T* TryGet(size_t index) noexcept {
+        return const_cast<T*>(std::as_const(*this).TryGet(index));
+    }
+
+    //  , ,    EmplaceBack
+    const T& operator[](size_t index) const noexcept {
+        const T* elem = TryGet(index);
+        assert(elem != nullptr);
+        return *elem;
+    }
+
+    T& operator[](size_t index) noexcept {
+        T* elem = TryGet(index);
+        assert(elem != nullptr);
+        return *elem;
+    }
+
+    //         Vector    .
+    // ,    
+    Vector<T> Freeze() {
+        const size_t size = size_.load(std::memory_order_acquire);
+        size_t published = 0;
+        ForEachPublished(size, [&published](Slot& /*slot*/) {
+            ++published;
+        });
+        Vector<T> result;
+        result.Reserve(published);
+        ForEachPublished(size, [&result](Slot& slot) {
+            result.EmplaceBack(std::move_if_noexcept(*slot.Get()));
+        });
+        Clear();
+        return result;
+    }
+
+    //      .      
+    void Clear() noexcept {
+        const size_t size = size_.load(std::memory_order_acquire);
+        ForEachPublished(size, [](Slot& slot) {
+            std::destroy_at(slot.Get());
+        });
+        for (std::atomic<Slot*>& segment : segments_) {
+            delete[] segment.exchange(nullptr, std::memory_order_acq_rel);
+        }
+        size_.store(0, std::memory_order_release);
+    }
+
+private:
+    static constexpr size_t SegmentSize(size_t segment) noexcept {
+        return FIRST_SEGMENT_SIZE << segment;
+    }
+
+    //      .  k    FIRST_SEGMENT_SIZE * (2^k - 1)
+    static std::pair<size_t, size_t> Locate(size_t index) noexcept {
+        const size_t scaled = index / FIRST_SEGMENT_SIZE + 1;
+        size_t segment = 0;
+        while ((scaled >> (segment + 1)) != 0) {
+            ++segment;
+        }
+        return { segment, index - FIRST_SEGMENT_SIZE * ((size_t{ 1 } << segment) - 1) };
+    }
+
+    Slot* AcquireSegment(size_t segment) {
+        assert(segment < NUM_SEGMENTS);
+        Slot* slots = segments_[segment].load(std::memory_order_acquire);
+        if (slots != nullptr) {
+            return slots;
+        }
+        Slot* fresh = new Slot[SegmentSize(segment)];
+        if (segments_[segment].compare_exchange_strong(slots, fresh, std::memory_order_acq_rel,
+                                                       std::memory_order_acquire)) {
+            return fresh;
+        }
+        //     
+        delete[] fresh;
+        return slots;
+    }
+
+    template <typename Func>
+    void ForEachPublished(size_t size, Func func) {
+        for (size_t segment = 0; segment < NUM_SEGMENTS && FIRST_SEGMENT_SIZE * ((size_t{ 1 } << segment) - 1) < size;
+             ++segment) {
+            Slot* slots = segments_[segment].load(std::memory_order_acquire);
+            if (slots == nullptr) {
+                continue;
+            }
+            const size_t first = FIRST_SEGMENT_SIZE * ((size_t{ 1 } << segment) - 1);
+            const size_t count = std::min(SegmentSize(segment), size - first);
+            for (size_t offset = 0; offset < count; ++offset) {
+                if (slots[offset].published.load(std::memory_order_acquire)) {
+                    func(slots[offset]);
+                }
+            }
+        }
+    }
+
+    std::atomic<Slot*> segments_[NUM_SEGMENTS] = {};
+    std::atomic<size_t> size_{ 0 };
+};
@@ -0,0 +1,463 @@
+#pragma once
+#include "vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+namespace flat {
+
+    //     data  size,   key.   :
+    //     ,        
+    //  ,         
+    template <typename K, typename Key, typename Compare>
+    size_t LowerBound(const K* data, size_t size, const Key& key, const Compare& comp) {
+        if (size == 0) {
+            return 0;
+        }
+        const K* base = data;
+        while (size > 1) {
+            const size_t half = size / 2;
+#if defined(__GNUC__)
+            __builtin_prefetch(base + half / 2);
+            __builtin_prefetch(base + half + half / 2);
+#endif
+            base = comp(base[half - 1], key) ? base + half : base;
+            size -= half;
+        }
+        return static_cast<size_t>(base - data) + static_cast<size_t>(comp(*base, key));
+    }
+
+    //        ,  
+    template <typename ForwardIt, typename Compare>
+    ForwardIt UniqueSorted(ForwardIt first, ForwardIt last, const Compare& comp) {
+        return std::unique(first, last, [&comp](const auto& lhs, const auto& rhs) {
+            return !comp(lhs, rhs);
+        });
+    }
+
+    //   ,         size:
+    //   O(size),      
+    inline size_t BatchThreshold(size_t size) noexcept {
+        return std::max<size_t>(64, size / 16);
+    }
+
+}  // namespace flat
+
+//     Vector.  -    ,
+//    ,   std::set.     ,  
+//    InsertBuffered  Flush:       .
+//   Size    .     , 
+//        
+template <typename K, typename Compare = std::less<K>>
+class FlatSet {
+public:
+    using const_iterator = typename Vector<K>::const_iterator;
+
+    FlatSet() = default;
+
+    explicit FlatSet(const Compare& comp)
+        : comp_(comp) {
+    }
+
+    //   : ,     
+    template <typename InputIt, typename = std::enable_if_t<std::is_convertible_v<
+                                    typename std::iterator_traits<InputIt>::iterator_category, std::input_iterator_tag>>>
+    FlatSet(InputIt first, InputIt last, const Compare& comp = Compare())
+        : keys_(first, last)
+        , comp_(comp)
+    {
+        SortAndDedupe(keys_);
+    }
+
+    FlatSet(std::initializer_list<K> init, const Compare& comp = Compare())
+        : FlatSet(init.begin(), init.end(), comp) {
+    }
+
+    size_t Size() const noexcept {
+        return keys_.Size();
+    }
+
+    bool Empty() const noexcept {
+        return keys_.Size() == 0;
+    }
+
+    const_iterator begin() const noexcept {
+        return keys_.begin();
+    }
+
+    const_iterator end() const noexcept {
+        return keys_.end();
+    }
+
+    Span<const K> Keys() const noexcept {
+        return keys_.View();
+    }
+
+    void Reserve(size_t capacity) {
+        keys_.Reserve(capacity);
+    }
+
+    const_iterator LowerBound(const K& key) const {
+        return keys_.begin() + flat::LowerBound(keys_.Data(), keys_.Size(), key, comp_);
+    }
+
+    const_iterator Find(const K& key) const {
+        const_iterator it = LowerBound(key);
+        return it != end() && !comp_(key, *it) ? it : end();
+    }
+
+    bool Contains(const K& key) const {
+        return Find(key) != end();
+    }
+
+    //  key,   .  true,   
+    bool Insert(const K& key) {
+        Flush();
+        const_iterator it = LowerBound(key);
+        if (it != end() && !comp_(key, *it)) {
+            return false;
+        }
+        keys_.Insert(it, key);
+        return true;
+    }
+
+    //    :  ,   
+    template <typename InputIt>
+    void InsertBulk(InputIt first, InputIt last) {
+        Flush();
+        Vector<K> keys(first, last);
+        SortAndDedupe(keys);
+        Merge(keys);
+    }
+
+    //   key  Flush.   ,    .
+    //      Find, Contains  Size
+    void InsertBuffered(const K& key) {
+        pending_.PushBack(key);
+        if (pending_.Size() >= flat::BatchThreshold(keys_.Size())) {
+            Flush();
+        }
+    }
+
+    //      
+    void Flush() {
+        if (pending_.Size() == 0) {
+            return;
+        }
+        SortAndDedupe(pending_);
+        Merge(pending_);
+        pending_.Clear();
+    }
+
+    size_t PendingSize() const noexcept {
+        return pending_.Size();
+    }
+
+    //  key,    .  true,   
+    bool Erase(const K& key) {
+        Flush();
+        const_iterator it = Find(key);
+        if (it == end()) {
+            return false;
+        }
+        keys_.Erase(it);
+        return true;
+    }
+
+    void Clear() noexcept {
+        keys_.Clear();
+        pending_.Clear();
+    }
+
+private:
+    void SortAndDedupe(Vector<K>& keys) {
+        std::sort(keys.begin(), keys.end(), comp_);
+        keys.Erase(flat::UniqueSorted(keys.begin(), keys.end(), comp_), keys.end());
+    }
+
+    //        .    
+    //   
+    void Merge(const Vector<K>& keys) {
+        keys_.InsertSorted(keys.begin(), keys.end(), comp_);
+        keys_.Erase(flat::UniqueSorted(keys_.begin(), keys_.end(), comp_), keys_.end());
+    }
+
+    Vector<K> keys_;
+    Vector<K> pending_;
+    Compare comp_;
+};
+
+//      Vector:   .   
+//   ,     .  i -  KeyAt(i), ValueAt(i).
+//        . , At  Size 
+//    InsertBuffered;     
+template <typename K, typename V, typename Compare = std::less<K>>
+class FlatMap {
+public:
+    FlatMap() = default;
+
+    explicit FlatMap(const Compare& comp)
+        : comp_(comp) {
+    }
+
+    //   :      .    
+    //   ,   std::map
+    template <typename InputIt, typename = std::enable_if_t<std::is_convertible_v<
+                                    typename std::iterator_traits<InputIt>::iterator_category, std::input_iterator_tag>>>
+    FlatMap(InputIt first, InputIt last, const Compare& comp = Compare())
+        : comp_(comp)
+    {
+        Vector<std::pair<K, V>> entries(first, last);
+        SortAndDedupe(entries);
+        Assign(entries);
+    }
+
+    FlatMap(std::initializer_list<std::pair<K, V>> init, const Compare& comp = Compare())
+        : FlatMap(init.begin(), init.end(), comp) {
+    }
+
+    size_t Size() const noexcept {
+        return keys_.Size();
+    }
+
+    bool Empty() const noexcept {
+        return keys_.Size() == 0;
+    }
+
+    const K& KeyAt(size_t index) const noexcept {
+        return keys_[index];
+    }
+
+    V& ValueAt(size_t index) noexcept {
+        return values_[index];
+    }
+
+    const V& ValueAt(size_t index) const noexcept {
+        return values_[index];
+    }
+
+    Span<const K> Keys() const noexcept {
+        return keys_.View();
+    }
+
+    Span<V> Values() noexcept {
+        return values_.View();
+    }
+
+    Span<const V> Values() const noexcept {
+        return values_.View();
+    }
+
+    void Reserve(size_t capacity) {
+        keys_.Reserve(capacity);
+        values_.Reserve(capacity);
+    }
+
+    //   ,   key
+    size_t LowerBound(const K& key) const {
+        return flat::LowerBound(keys_.Data(), keys_.Size(), key, comp_);
+    }
+
+    const V* Find(const K& key) const {
+        const size_t index = IndexOf(key);
+        return index != keys_.Size() ? &values_[index] : nullptr;
+    }
+
+    V* Find(const K& key) {
+        return const_cast<V*>(std::as_const(*this).Find(key));
+    }
+
+    bool Contains(const K& key) const {
+        return IndexOf(key) != keys_.Size();
+    }
+
+    const V& At(const K& key) const {
+        const V* value = Find(key);
+        if (value == nullptr) {
+            throw std::out_of_range("FlatMap::At: no such key");
+        }
+        return *value;
+    }
+
+    V& At(const K& key) {
+        return const_cast<V&>(std::as_const(*this).At(key));
+    }
+
+    //  ,   args,   .     
+    //  
+    template <typename... Args>
+    std::pair<V*, bool> TryEmplace(const K& key, Args&&... args) {
+        Flush();
+        const size_t index = LowerBound(key);
+        if (index != keys_.Size() && !comp_(key, keys_[index])) {
+            return { &values_[index], false };
+        }
+        values_.Emplace(values_.begin() + index, std::forward<Args>(args)...);
+        try {
+            keys_.Insert(keys_.begin() + index, key);
+        }
+        catch (...) {
+            values_.Erase(values_.begin() + index);
+            throw;
+        }
+        return { &values_[index], true };
+    }
+
+    bool Insert(const K& key, const V& value) {
+        return TryEmplace(key, value).second;
+    }
+
+    //    .  true,   
+    template <typename U>
+    bool InsertOrAssign(const K& key, U&& value) {
+        const auto [slot, inserted] = TryEmplace(key, std::forward<U>(value));
+        if (!inserted) {
+            *slot = std::forward<U>(value);
+        }
+        return inserted;
+    }
+
+    V& operator[](const K& key) {
+        return *TryEmplace(key).first;
+    }
+
+    //    .      
+    template <typename InputIt>
+    void InsertBulk(InputIt first, InputIt last) {
+        Flush();
+        Vector<std::pair<K, V>> entries(first, last);
+        SortAndDedupe(entries);
+        Merge(entries, false);
+    }
+
+    //     Flush.    InsertOrAssign:    
+    //   .   ,    .
+    //      Find, Contains, At  Size
+    template <typename U>
+    void InsertBuffered(const K& key, U&& value) {
+        pending_.EmplaceBack(key, std::forward<U>(value));
+        if (pending_.Size() >= flat::BatchThreshold(keys_.Size())) {
+            Flush();
+        }
+    }
+
+    //        O(Size() + k log k)
+    void Flush() {
+        if (pending_.Size() == 0) {
+            return;
+        }
+        //         
+        std::reverse(pending_.begin(), pending_.end());
+        SortAndDedupe(pending_);
+        Merge(pending_, true);
+        pending_.Clear();
+    }
+
+    size_t PendingSize() const noexcept {
+        return pending_.Size();
+    }
+
+    //  key,    .  true,   
+    bool Erase(const K& key) {
+        Flush();
+        const size_t index = IndexOf(key);
+        if (index == keys_.Size()) {
+            return false;
+        }
+        keys_.Erase(keys_.begin() + index);
+        values_.Erase(values_.begin() + index);
+        return true;
+    }
+
+    void Clear() noexcept {
+        keys_.Clear();
+        values_.Clear();
+        pending_.Clear();
+    }
+
+private:
+    using Entry = std::pair<K, V>;
+
+    size_t IndexOf(const K& key) const {
+        const size_t index = LowerBound(key);
+        return index != keys_.Size() && !comp_(key, keys_[index]) ? index : keys_.Size();
+    }
+
+    void SortAndDedupe(Vector<Entry>& entries) const {
+        const auto by_key = [this](const Entry& lhs, const Entry& rhs) {
+            return comp_(lhs.first, rhs.first);
+        };
+        std::stable_sort(entries.begin(), entries.end(), by_key);
+        entries.Erase(flat::UniqueSorted(entries.begin(), entries.end(), by_key), entries.end());
+    }
+
+    void Assign(Vector<Entry>& entries) {
+        Vector<K> keys;
+        Vector<V> values;
+        keys.Reserve(entries.Size());
+        values.Reserve(entries.Size());
+        for (Entry& entry : entries) {
+            keys.PushBack(std::move(entry.first));
+            values.PushBack(std::move(entry.second));
+        }
+        keys_.Swap(keys);
+        values_.Swap(values);
+    }
+
+    //       ,   
+    static constexpr bool NOTHROW_MOVE
+        = std::is_nothrow_move_constructible_v<K> && std::is_nothrow_move_constructible_v<V>;
+
+    template <typename T>
+    static std::conditional_t<NOTHROW_MOVE, T&&, const T&> Take(T& value) noexcept {
+        return static_cast<std::conditional_t<NOTHROW_MOVE, T&&, const T&>>(value);
+    }
+
+    //             
+    // .     ,  replace,   .
+    //     entries  
+    void Merge(Vector<Entry>& entries, bool replace) {
+        Vector<K> keys;
+        Vector<V> values;
+        keys.Reserve(keys_.Size() + entries.Size());
+        values.Reserve(keys_.Size() + entries.Size());
+        size_t i = 0;
+        for (Entry& entry : entries) {
+            for (; i < keys_.Size() && comp_(keys_[i], entry.first); ++i) {
+                keys.PushBack(Take(keys_[i]));
+                values.PushBack(Take(values_[i]));
+            }
+            if (i < keys_.Size() && !comp_(entry.first, keys_[i])) {
+                keys.PushBack(Take(keys_[i]));
+                if (replace) {
+                    values.PushBack(Take(entry.second));
+                }
+                else {
+                    values.PushBack(Take(values_[i]));
+                }
+                ++i;
+            }
+            else {
+                keys.PushBack(Take(entry.first));
+                values.PushBack(Take(entry.second));
+            }
+        }
+        for (; i < keys_.Size(); ++i) {
+            keys.PushBack(Take(keys_[i]));
+            values.PushBack(Take(values_[i]));
+        }
+        keys_.Swap(keys);
+        values_.Swap(values);
+    }
+
+    Vector<K> keys_;
+    Vector<V> values_;
+    Vector<Entry> pending_;
+    Compare comp_;
+};
@@ -0,0 +1,320 @@
+#pragma once
+#include "vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+//   N    .  ,     
+//     ,         
+template <typename T, size_t N>
+struct InplaceBuffer {
+    //      ;  T      
+    T* Data() noexcept {
+        return reinterpret_cast<T*>(storage);
+    }
+
+    const T* Data() const noexcept {
+        return reinterpret_cast<const T*>(storage);
+    }
+
+    //   index. std::launder   ,   T  
+    T& Elem(size_t index) noexcept {
+        return *std::launder(Data() + index);
+    }
+
+    const T& Elem(size_t index) const noexcept {
+        return *std::launder(Data() + index);
+    }
+
+    alignas(T) unsigned char storage[(N == 0 ? 1 : N) * sizeof(T)];
+    size_t size = 0;
+};
+
+//    T     
+template <typename T, size_t N, bool = std::is_trivially_copyable_v<T>>
+struct InplaceStorage : InplaceBuffer<T, N> {};
+
+template <typename T, size_t N>
+struct InplaceStorage<T, N, false> : InplaceBuffer<T, N> {
+    InplaceStorage() = default;
+
+    InplaceStorage(const InplaceStorage& other) {
+        std::uninitialized_copy_n(other.Data(), other.size, this->Data());
+        this->size = other.size;
+    }
+
+    InplaceStorage(InplaceStorage&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        std::uninitialized_move_n(other.Data(), other.size, this->Data());
+        this->size = other.size;
+    }
+
+    InplaceStorage& operator=(const InplaceStorage& rhs) {
+        if (this != &rhs) {
+            AssignFrom(rhs.Data(), rhs.size);
+        }
+        return *this;
+    }
+
+    InplaceStorage& operator=(InplaceStorage&& rhs) noexcept(std::is_nothrow_move_assignable_v<T>
+                                                             && std::is_nothrow_move_constructible_v<T>) {
+        if (this != &rhs) {
+            AssignFrom(std::make_move_iterator(rhs.Data()), rhs.size);
+        }
+        return *this;
+    }
+
+    ~InplaceStorage() {
+        std::destroy_n(this->Data(), this->size);
+    }
+
+private:
+    //   ,   ,  
+    template <typename RandomIt>
+    void AssignFrom(RandomIt src, size_t n) {
+        T* data = this->Data();
+        const size_t common = std::min(n, this->size);
+        std::copy_n(src, common, data);
+        if (n > this->size) {
+            std::uninitialized_copy_n(std::next(src, common), n - common, data + common);
+        }
+        else {
+            std::destroy_n(data + n, this->size - n);
+        }
+        this->size = n;
+    }
+};
+
+//   N ,     .      
+// ,           .  
+//  T    :    memcpy,  
+//     .     std::bad_alloc,
+//   std::inplace_vector; TryEmplaceBack    nullptr
+template <typename T, size_t N>
+class InplaceVector : private InplaceStorage<T, N> {
+    using Storage = InplaceStorage<T, N>;
+
+public:
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    InplaceVector() = default;
+
+    explicit InplaceVector(size_t size) {
+        Resize(size);
+    }
+
+    InplaceVector(std::initializer_list<T> init) {
+        CheckCapacity(init.size());
+        std::uninitialized_copy_n(init.begin(), init.size(), Data());
+        this->size = init.size();
+    }
+
+    static constexpr size_t Capacity() noexcept {
+        return N;
+    }
+
+    size_t Size() const noexcept {
+        return this->size;
+    }
+
+    bool Empty() const noexcept {
+        return this->size == 0;
+    }
+
+    bool Full() const noexcept {
+        return this->size == N;
+    }
+
+    T* Data() noexcept {
+        return Storage::Data();
+    }
+
+    const T* Data() const noexcept {
+        return Storage::Data();
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < this->size);
+        return Storage::Elem(index);
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        assert(index < this->size);
+        return Storage::Elem(index);
+    }
+
+    Span<T> View() noexcept {
+        return { Data(), this->size };
+    }
+
+    Span<const T> View() const noexcept {
+        return { Data(), this->size };
+    }
+
+    iterator begin() noexcept {
+        return Data();
+    }
+    iterator end() noexcept {
+        return Data() + this->size;
+    }
+    const_iterator begin() const noexcept {
+        return Data();
+    }
+    const_iterator end() const noexcept {
+        return Data() + this->size;
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    //   ,   args,  nullptr,   
+    template <typename... Args>
+    T* TryEmplaceBack(Args&&... args) {
+        if (Full()) {
+            return nullptr;
+        }
+        T* elem = new (end()) T(std::forward<Args>(args)...);
+        ++this->size;
+        return elem;
+    }
+
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        CheckCapacity(this->size + 1);
+        return *TryEmplaceBack(std::forward<Args>(args)...);
+    }
+
+    template <typename Total>
+    void PushBack(Total&& value) {
+        EmplaceBack(std::forward<Total>(value));
+    }
+
+    void PopBack() noexcept {
+        assert(this->size != 0);
+        std::destroy_at(end() - 1);
+        --this->size;
+    }
+
+    void Clear() noexcept {
+        std::destroy_n(Data(), this->size);
+        this->size = 0;
+    }
+
+    //     T{}
+    void Resize(size_t new_size) {
+        if (new_size < this->size) {
+            std::destroy_n(Data() + new_size, this->size - new_size);
+        }
+        else {
+            CheckCapacity(new_size);
+            UninitializedValueConstructN(end(), new_size - this->size);
+        }
+        this->size = new_size;
+    }
+
+    //  ,   args,  pos.    T 
+    //  memmove.       
+    template <typename... Args>
+    iterator Emplace(const_iterator pos, Args&&... args) {
+        const size_t index = pos - cbegin();
+        CheckCapacity(this->size + 1);
+        if (pos == cend()) {
+            return TryEmplaceBack(std::forward<Args>(args)...);
+        }
+        T* gap = Data() + index;
+        const size_t tail = this->size - index;
+        if constexpr (is_trivially_relocatable_v<T>) {
+            if (!ArgsMayAlias(Data(), this->size, args...)) {
+                std::memmove(static_cast<void*>(gap + 1), static_cast<const void*>(gap), tail * sizeof(T));
+                try {
+                    new (gap) T(std::forward<Args>(args)...);
+                }
+                catch (...) {
+                    std::memmove(static_cast<void*>(gap), static_cast<const void*>(gap + 1), tail * sizeof(T));
+                    throw;
+                }
+            }
+            else {
+                alignas(T) unsigned char storage[sizeof(T)];
+                T* elem = new (storage) T(std::forward<Args>(args)...);
+                std::memmove(static_cast<void*>(gap + 1), static_cast<const void*>(gap), tail * sizeof(T));
+                UninitializedRelocateN(elem, 1, gap);
+            }
+        }
+        else {
+            T tmp(std::forward<Args>(args)...);
+            new (end()) T(std::move(*(end() - 1)));
+            try {
+                std::move_backward(gap, end() - 1, end());
+            }
+            catch (...) {
+                std::destroy_at(end());
+                throw;
+            }
+            *gap = std::move(tmp);
+        }
+        ++this->size;
+        return gap;
+    }
+
+    iterator Insert(const_iterator pos, const T& value) {
+        return Emplace(pos, value);
+    }
+
+    iterator Insert(const_iterator pos, T&& value) {
+        return Emplace(pos, std::move(value));
+    }
+
+    iterator Erase(const_iterator pos) {
+        return Erase(pos, pos + 1);
+    }
+
+    //   [first, last),    
+    iterator Erase(const_iterator first, const_iterator last) {
+        const size_t index = first - cbegin();
+        const size_t count = last - first;
+        iterator it_first = begin() + index;
+        if (count == 0) {
+            return it_first;
+        }
+        if constexpr (is_trivially_relocatable_v<T>) {
+            const size_t tail = cend() - last;
+            std::destroy_n(it_first, count);
+            std::memmove(static_cast<void*>(it_first), static_cast<const void*>(it_first + count), tail * sizeof(T));
+        }
+        else {
+            std::move(it_first + count, end(), it_first);
+            std::destroy_n(end() - count, count);
+        }
+        this->size -= count;
+        return it_first;
+    }
+
+    //     :        
+    void Swap(InplaceVector& other) {
+        InplaceVector* shorter = this->size <= other.size ? this : &other;
+        InplaceVector* longer = shorter == this ? &other : this;
+        const size_t common = shorter->size;
+        std::swap_ranges(shorter->begin(), shorter->end(), longer->begin());
+        UninitializedRelocateN(longer->begin() + common, longer->size - common, shorter->begin() + common);
+        std::swap(this->size, other.size);
+    }
+
+private:
+    static void CheckCapacity(size_t size) {
+        if (size > N) {
+            throw std::bad_alloc();
+        }
+    }
+};
@@ -1,8 +1,35 @@
 #include "vector.h"
+#include "allocators.h"
+#include "concurrent_vector.h"
+#include "flat_map.h"
+#include "inplace_vector.h"
+#include "mapped_vector.h"
+#include "small_vector.h"
+#include "segmented_vector.h"
+#include "soa_vector.h"
+#include "vector_algorithms.h"
+#include "vector_serialization.h"
 
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
 #include <iostream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <sstream>
 #include <stdexcept>
+#include <streambuf>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
 
 namespace {
@@ -116,6 +143,114 @@ namespace {
         static inline int num_move_assigned = 0;
     };
 
+    //       ,    
+    struct Relocatable {
+        explicit Relocatable(int id)
+            : id(std::make_unique<int>(id)) {
+        }
+        Relocatable(Relocatable&& other) noexcept
+            : id(std::move(other.id)) {
+            ++num_moved;
+        }
+        Relocatable& operator=(Relocatable&& other) noexcept = default;
+        ~Relocatable() {
+            ++num_destroyed;
+        }
+
+        static void ResetCounters() {
+            num_moved = 0;
+            num_destroyed = 0;
+        }
+
+        std::unique_ptr<int> id;
+
+        static inline int num_moved = 0;
+        static inline int num_destroyed = 0;
+    };
+
+}  // namespace
+
+template <>
+struct is_trivially_relocatable<Relocatable> : std::true_type {};
+
+namespace {
+
+    //      ,    Obj, 
+    struct ThreadSafeObj {
+        ThreadSafeObj() {
+            if (throw_countdown.fetch_sub(1) == 1) {
+                throw std::runtime_error("Oops");
+            }
+            ++num_alive;
+        }
+
+        ThreadSafeObj(const ThreadSafeObj& other)
+            : id(other.id) {
+            if (other.throw_on_copy) {
+                throw std::runtime_error("Oops");
+            }
+            ++num_alive;
+        }
+
+        ThreadSafeObj& operator=(const ThreadSafeObj& rhs) {
+            if (rhs.throw_on_copy) {
+                throw std::runtime_error("Oops");
+            }
+            id = rhs.id;
+            return *this;
+        }
+
+        ~ThreadSafeObj() {
+            --num_alive;
+        }
+
+        static void ResetCounters() {
+            throw_countdown = 0;
+            num_alive = 0;
+        }
+
+        bool throw_on_copy = false;
+        int id = 0;
+
+        //     ,     
+        static inline std::atomic<int> throw_countdown = 0;
+        static inline std::atomic<int> num_alive = 0;
+    };
+
+    struct ParserTag {
+        static constexpr std::string_view NAME = "parser";
+    };
+
+    struct RowsTag {
+        static constexpr std::string_view NAME = "rows";
+    };
+
+    //  ,   int  
+    struct MoveCounter {
+        explicit MoveCounter(int id = 0) noexcept
+            : id(id) {
+        }
+        MoveCounter(MoveCounter&& other) noexcept
+            : id(other.id) {
+            ++num_move_constructed;
+        }
+        MoveCounter& operator=(MoveCounter&& other) noexcept {
+            id = other.id;
+            ++num_move_assigned;
+            return *this;
+        }
+
+        static void ResetCounters() {
+            num_move_constructed = 0;
+            num_move_assigned = 0;
+        }
+
+        int id;
+
+        static inline int num_move_constructed = 0;
+        static inline int num_move_assigned = 0;
+    };
+
 }  // namespace
 
 void Test1() {
@@ -437,7 +572,7 @@ void Test6() {
     {
         Obj::ResetCounters();
         Vector<Obj> v;
-        auto* pos = v.Emplace(v.end(), Obj{ 1 });
+        auto pos = v.Emplace(v.end(), Obj{ 1 });
         assert(v.Size() == 1);
         assert(v.Capacity() >= v.Size());
         assert(&*pos == &v[0]);
@@ -452,7 +587,7 @@ void Test6() {
         Obj::ResetCounters();
         Vector<Obj> v;
         v.Reserve(SIZE);
-        auto* pos = v.Emplace(v.end(), Obj{ 1 });
+        auto pos = v.Emplace(v.end(), Obj{ 1 });
         assert(v.Size() == 1);
         assert(v.Capacity() >= v.Size());
         assert(&*pos == &v[0]);
@@ -499,7 +634,7 @@ void Test6() {
     {
         Obj::ResetCounters();
         Vector<Obj> v{ SIZE };
-        auto* pos = v.Emplace(v.cbegin() + 1, ID, "Ivan"s);
+        auto pos = v.Emplace(v.cbegin() + 1, ID, "Ivan"s);
         assert(v.Size() == SIZE + 1);
         assert(v.Capacity() == SIZE * 2);
         assert(&*pos == &v[1]);
@@ -515,7 +650,7 @@ void Test6() {
     {
         Obj::ResetCounters();
         Vector<Obj> v{ SIZE };
-        auto* pos = v.Emplace(v.cbegin() + v.Size(), ID, "Ivan"s);
+        auto pos = v.Emplace(v.cbegin() + v.Size(), ID, "Ivan"s);
         assert(v.Size() == SIZE + 1);
         assert(v.Capacity() == SIZE * 2);
         assert(&*pos == &v[SIZE]);
@@ -534,7 +669,7 @@ void Test6() {
         v.Reserve(SIZE * 2);
         const int old_num_moved = Obj::num_moved;
         assert(v.Capacity() == SIZE * 2);
-        auto* pos = v.Emplace(v.cbegin() + 3, ID, "Ivan"s);
+        auto pos = v.Emplace(v.cbegin() + 3, ID, "Ivan"s);
         assert(v.Size() == SIZE + 1);
         assert(&*pos == &v[3]);
         assert(v[3].id == ID);
@@ -550,7 +685,7 @@ void Test6() {
         Obj::ResetCounters();
         Vector<Obj> v{ SIZE };
         v[2].id = ID;
-        auto* pos = v.Erase(v.cbegin() + 1);
+        auto pos = v.Erase(v.cbegin() + 1);
         assert((pos - v.begin()) == 1);
         assert(v.Size() == SIZE - 1);
         assert(v.Capacity() == SIZE);
@@ -563,86 +698,2201 @@ void Test6() {
     }
 }
 
-struct C {
-    C() noexcept {
-        ++def_ctor;
+void Test7() {
+    const size_t SIZE = 1000;
+    const int ID = 42;
+    {
+        Obj::ResetCounters();
+        Arena arena;
+        {
+            Vector<Obj, ArenaAllocator<Obj>> v{ ArenaAllocator<Obj>(arena) };
+            for (size_t i = 0; i < SIZE; ++i) {
+                v.EmplaceBack(static_cast<int>(i));
+            }
+            assert(v.Size() == SIZE);
+            assert(v[SIZE - 1].id == static_cast<int>(SIZE - 1));
+            assert(&v.GetAllocator().GetArena() == &arena);
+            assert(arena.BytesAllocated() >= SIZE * sizeof(Obj));
+
+            //      
+            const auto v_copy(v);
+            assert(v_copy.GetAllocator() == v.GetAllocator());
+            assert(v_copy[ID].id == ID);
+        }
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+    {
+        Obj::ResetCounters();
+        Arena arena1;
+        Arena arena2;
+        Vector<Obj, ArenaAllocator<Obj>> v1(SIZE, ArenaAllocator<Obj>(arena1));
+        Vector<Obj, ArenaAllocator<Obj>> v2{ ArenaAllocator<Obj>(arena2) };
+        v1[ID].id = ID;
+
+        //   : v2     
+        v2 = v1;
+        assert(&v2.GetAllocator().GetArena() == &arena2);
+        assert(v2.Size() == SIZE);
+        assert(v2[ID].id == ID);
+        assert(Obj::num_copied == SIZE);
+
+        //      
+        Vector<Obj, ArenaAllocator<Obj>> v3{ ArenaAllocator<Obj>(arena2) };
+        v3 = std::move(v1);
+        assert(&v3.GetAllocator().GetArena() == &arena2);
+        assert(v3.Size() == SIZE);
+        assert(v3[ID].id == ID);
+        assert(Obj::num_moved == SIZE);
+
+        //        
+        const Obj* data = &v3[0];
+        Vector<Obj, ArenaAllocator<Obj>> v4{ ArenaAllocator<Obj>(arena2) };
+        v4 = std::move(v3);
+        assert(&v4[0] == data);
+        assert(Obj::num_moved == SIZE);
+
+        v2.Swap(v4);
+        assert(&v2[0] == data);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        Pool pool;
+        //     :      
+        std::uintptr_t data = 0;
+        size_t capacity = 0;
+        {
+            Vector<int, PoolAllocator<int>> v{ PoolAllocator<int>(pool) };
+            for (int i = 0; i < ID; ++i) {
+                v.PushBack(i);
+            }
+            assert(v.Size() == static_cast<size_t>(ID));
+            assert(v[ID - 1] == ID - 1);
+            data = reinterpret_cast<std::uintptr_t>(&v[0]);
+            capacity = v.Capacity();
+        }
+        //             
+        Vector<int, PoolAllocator<int>> v(capacity, PoolAllocator<int>(pool));
+        assert(reinterpret_cast<std::uintptr_t>(&v[0]) == data);
+    }
+    {
+        Pool pool;
+        Vector<int, PoolAllocator<int>> v(Pool::MAX_CLASS_SIZE, PoolAllocator<int>(pool));
+        v[Pool::MAX_CLASS_SIZE - 1] = ID;
+        assert(v[Pool::MAX_CLASS_SIZE - 1] == ID);
+    }
+}
+
+void Test8() {
+    const size_t SIZE = 100;
+    const size_t INDEX = 10;
+    static_assert(is_trivially_relocatable_v<int>);
+    static_assert(is_trivially_relocatable_v<std::unique_ptr<int>>);
+    static_assert(!is_trivially_relocatable_v<Obj>);
+    static_assert(!is_trivially_relocatable_v<std::string>);
+    {
+        Relocatable::ResetCounters();
+        Vector<Relocatable> v;
+        v.Reserve(SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        v.Emplace(v.cbegin() + INDEX, -1);
+        assert(v.Capacity() == SIZE * 2);
+        v.Reserve(SIZE * 4);
+        v.EmplaceBack(static_cast<int>(SIZE));
+        assert(v.Capacity() == SIZE * 4);
+        //         ,  
+        assert(Relocatable::num_moved == 0);
+        assert(Relocatable::num_destroyed == 0);
+        assert(*v[INDEX].id == -1);
+        assert(*v[INDEX + 1].id == static_cast<int>(INDEX));
+        assert(*v[SIZE].id == static_cast<int>(SIZE - 1));
+    }
+    assert(Relocatable::num_destroyed == static_cast<int>(SIZE + 2));
+    {
+        Vector<std::unique_ptr<int>> v;
+        v.PushBack(std::make_unique<int>(1));
+        const int* first = v[0].get();
+        for (size_t i = 1; i < SIZE; ++i) {
+            v.PushBack(std::make_unique<int>(static_cast<int>(i)));
+        }
+        v.Insert(v.cbegin() + INDEX, std::make_unique<int>(-1));
+        assert(v[0].get() == first);
+        assert(*v[INDEX] == -1);
+        assert(*v[SIZE] == static_cast<int>(SIZE - 1));
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        v.Reserve(SIZE * 2);
+        assert(v.Capacity() == SIZE * 2);
+        assert(Obj::num_moved == static_cast<int>(SIZE));
+        assert(Obj::num_destroyed == static_cast<int>(SIZE));
+    }
+}
+
+void Test9() {
+    const size_t SIZE = 100'000;
+    const size_t INDEX = 10;
+    {
+        Vector<int, MallocAllocator<int>> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<int>(i));
+        }
+        assert(v.Size() == SIZE);
+        assert(v[SIZE - 1] == static_cast<int>(SIZE - 1));
+
+        v.Resize(v.Capacity());
+        //     ,     realloc
+        v.PushBack(v[INDEX]);
+        v.Insert(v.cbegin() + 1, v[INDEX]);
+        assert(v[1] == static_cast<int>(INDEX));
+        assert(v[INDEX + 1] == static_cast<int>(INDEX));
+        assert(v[v.Size() - 1] == static_cast<int>(INDEX));
+    }
+    {
+        Relocatable::ResetCounters();
+        {
+            Vector<Relocatable, MallocAllocator<Relocatable>> v;
+            v.Reserve(INDEX);
+            for (size_t i = 0; i < INDEX; ++i) {
+                v.EmplaceBack(static_cast<int>(i));
+            }
+            v.Emplace(v.cbegin() + 1, -1);
+            v.Reserve(SIZE);
+            assert(v.Size() == INDEX + 1);
+            assert(*v[1].id == -1);
+            assert(*v[INDEX].id == static_cast<int>(INDEX - 1));
+            assert(Relocatable::num_moved == 0);
+            assert(Relocatable::num_destroyed == 0);
+        }
+        assert(Relocatable::num_destroyed == static_cast<int>(INDEX + 1));
+    }
+    {
+        Arena arena;
+        Vector<int, ArenaAllocator<int>> v{ ArenaAllocator<int>(arena) };
+        v.PushBack(1);
+        const int* data = &v[0];
+        //   -   ,     
+        for (size_t i = 0; i < INDEX * INDEX; ++i) {
+            v.PushBack(static_cast<int>(i));
+        }
+        assert(&v[0] == data);
+        assert(arena.BytesAllocated() == v.Capacity() * sizeof(int));
+
+        Vector<int, ArenaAllocator<int>> other{ ArenaAllocator<int>(arena) };
+        other.PushBack(1);
+        v.Reserve(v.Capacity() * 2);
+        assert(&v[0] != data);
+        assert(v[0] == 1);
+        assert(v[v.Size() - 1] == static_cast<int>(INDEX * INDEX - 1));
+    }
+}
+
+void Test10() {
+    const size_t SIZE = 1000;
+    {
+        Vector<int> v;
+        v.PushBack(1);
+        //     MIN_INITIAL_BYTES 
+        assert(v.Capacity() == MIN_INITIAL_BYTES / sizeof(int));
     }
-    C(const C& /*other*/) noexcept {
-        ++copy_ctor;
+    {
+        Obj::ResetCounters();
+        Vector<Obj, std::allocator<Obj>, OneAndHalfGrowth> v(SIZE);
+        v.EmplaceBack(1);
+        assert(v.Capacity() == SIZE + SIZE / 2);
+        v.Emplace(v.cbegin(), 2);
+        assert(v.Capacity() == SIZE + SIZE / 2);
+        assert(v[0].id == 2);
+        assert(v[SIZE + 1].id == 1);
+        assert(Obj::num_moved == static_cast<int>(SIZE) + 1);
     }
-    C(C&& /*other*/) noexcept {
-        ++move_ctor;
+    {
+        Vector<char, std::allocator<char>, OneAndHalfGrowth> v;
+        size_t reallocations = 0;
+        for (size_t i = 0; i < SIZE; ++i) {
+            const size_t capacity = v.Capacity();
+            v.PushBack('a');
+            reallocations += capacity != v.Capacity();
+        }
+        // 64, 96, 144, 216, 324, 486, 729, 1093
+        assert(reallocations == 8);
     }
-    C& operator=(const C& other) noexcept {
-        if (this != &other) {
-            ++copy_assign;
+    {
+        Vector<Obj, std::allocator<Obj>, SizeClassGrowth> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+            const size_t bytes = v.Capacity() * sizeof(Obj);
+            if (bytes <= SizeClassGrowth::SMALL_LIMIT) {
+                assert((Pool::SizeClass(bytes) - bytes) < sizeof(Obj));
+            }
+            else {
+                assert(SizeClassGrowth::PAGE_SIZE - bytes % SizeClassGrowth::PAGE_SIZE < sizeof(Obj));
+            }
         }
-        return *this;
+        assert(v[SIZE - 1].id == static_cast<int>(SIZE - 1));
     }
-    C& operator=(C&& /*other*/) noexcept {
-        ++move_assign;
-        return *this;
+    {
+        Vector<int> v;
+        v.Reserve(SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.Emplace(v.end(), static_cast<int>(i));
+        }
+        assert(v.Capacity() == SIZE);
+        v.Emplace(v.end(), 0);
+        assert(v.Capacity() == SIZE * 2);
     }
-    ~C() {
-        ++dtor;
+}
+
+template <typename V, typename = void>
+struct HasRelease : std::false_type {};
+
+template <typename V>
+struct HasRelease<V, std::void_t<decltype(std::declval<V&>().Release())>> : std::true_type {};
+
+template <typename V, typename = void>
+struct HasReset : std::false_type {};
+
+template <typename V>
+struct HasReset<V, std::void_t<decltype(std::declval<V&>().Reset())>> : std::true_type {};
+
+template <typename V, typename = void>
+struct HasAdopt : std::false_type {};
+
+template <typename V>
+struct HasAdopt<V, std::void_t<decltype(std::declval<V&>().Adopt(std::declval<int*>(), size_t{}, size_t{}))>>
+    : std::true_type {};
+
+void Test11() {
+    const size_t N = 4;
+    const int ID = 42;
+    {
+        Obj::ResetCounters();
+        SmallVector<Obj, N> v;
+        assert(v.Capacity() == N);
+        for (size_t i = 0; i < N; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        assert(v.IsInline());
+        const auto* begin = reinterpret_cast<const char*>(&v);
+        const auto* elem = reinterpret_cast<const char*>(&v[N - 1]);
+        assert(elem >= begin && elem < begin + sizeof(v));
+        assert(Obj::num_moved == 0);
+
+        v.Insert(v.cbegin() + 1, Obj{ ID });
+        assert(!v.IsInline());
+        assert(v.Size() == N + 1);
+        assert(v[1].id == ID);
+        assert(v[N].id == static_cast<int>(N - 1));
+
+        v.Erase(v.cbegin() + 1);
+        v.Resize(N / 2);
+        assert(v.Size() == N / 2);
+        assert(v[1].id == 1);
     }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        Obj::ResetCounters();
+        SmallVector<Obj, N> v(N);
+        v[N - 1].throw_on_copy = true;
+        try {
+            //         
+            SmallVector<Obj, N> copy(v);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(Obj::GetAliveObjectCount() == N);
 
-    static void Reset() {
-        def_ctor = 0;
-        copy_ctor = 0;
-        move_ctor = 0;
-        copy_assign = 0;
-        move_assign = 0;
-        dtor = 0;
+        v[N - 1].throw_on_copy = false;
+        v[0].id = ID;
+        SmallVector<Obj, N> copy(v);
+        assert(copy.IsInline());
+        assert(copy[0].id == ID);
+
+        SmallVector<Obj, N> moved(std::move(copy));
+        assert(moved.IsInline());
+        assert(moved[0].id == ID);
+        assert(Obj::num_moved == static_cast<int>(N));
     }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        //       ,    
+        static_assert(std::is_nothrow_move_constructible_v<SmallVector<Obj, N>>);
+        static_assert(std::is_nothrow_move_assignable_v<SmallVector<Obj, N>>);
+        const size_t SIZE = N * 4;
+        SmallVector<Obj, N> v(SIZE);
+        const Obj* heap = v.Data();
+        const int moved_before = Obj::num_moved;
+        const int copied_before = Obj::num_copied;
+        SmallVector<Obj, N> moved(std::move(v));
+        assert(moved.Data() == heap && moved.Size() == SIZE);
+        assert(v.Size() == 0 && v.IsInline() && v.Capacity() == N);
+        SmallVector<Obj, N> assigned(N);
+        assigned = std::move(moved);
+        assert(assigned.Data() == heap && assigned.Size() == SIZE);
+        assert(moved.Size() == 0 && moved.IsInline());
+        assigned.Swap(moved);
+        assert(moved.Data() == heap && assigned.Size() == 0 && assigned.IsInline());
+        assert(Obj::num_moved == moved_before && Obj::num_copied == copied_before);
 
-    inline static size_t def_ctor = 0;
-    inline static size_t copy_ctor = 0;
-    inline static size_t move_ctor = 0;
-    inline static size_t copy_assign = 0;
-    inline static size_t move_assign = 0;
-    inline static size_t dtor = 0;
-};
+        v.EmplaceBack(ID);
+        Vector<SmallVector<Obj, N>> outer;
+        outer.PushBack(std::move(moved));
+        outer.EmplaceBack();
+        outer.EmplaceBack();
+        assert(outer[0].Data() == heap && outer[0].Size() == SIZE);
+        assert(Obj::num_copied == copied_before && v[0].id == ID);
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        SmallVector<int, N> small;
+        small.PushBack(1);
+        SmallVector<int, N> large;
+        for (size_t i = 0; i < N * 2; ++i) {
+            large.PushBack(static_cast<int>(i));
+        }
+        small.Swap(large);
+        assert(small.Size() == N * 2);
+        assert(!small.IsInline());
+        assert(large.Size() == 1);
+        assert(large[0] == 1);
+        assert(small[N * 2 - 1] == static_cast<int>(N * 2 - 1));
+        assert(large.Data() == &large[0] && small.Data() == &small[0]);
+        const SmallVector<int, N>& const_large = large;
+        assert(*const_large.Data() == 1);
 
-void Dump() {
-    using namespace std;
-    cerr << "Def ctors: "sv << C::def_ctor              //
-        << ", Copy ctors: "sv << C::copy_ctor          //
-        << ", Move ctors: "sv << C::move_ctor          //
-        << ", Copy assignments: "sv << C::copy_assign  //
-        << ", Move assignments: "sv << C::move_assign  //
-        << ", Dtors: "sv << C::dtor << endl;
+        //   SmallVector        
+        const Vector<int, InlineBufferAllocator<int, N>> heap_copy(large);
+        assert(heap_copy[0] == 1);
+        assert(&heap_copy[0] != &large[0]);
+    }
+    //            
+    {
+        Obj::ResetCounters();
+        SmallVector<Obj, N> src(N * 2);
+        src[N].throw_on_copy = true;
+        SmallVector<Obj, N> dst(1);
+        try {
+            dst = src;
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(dst.Size() == 0 && dst.IsInline() && dst.Capacity() == N);
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(N * 2));
+    }
+    // ,  SmallVector  , 
+    {
+        using Small = SmallVector<int, N>;
+        using Heap = Vector<int, InlineBufferAllocator<int, N>>;
+        static_assert(HasRelease<Heap>::value && HasReset<Heap>::value && HasAdopt<Heap>::value);
+        static_assert(!HasRelease<Small>::value && !HasReset<Small>::value && !HasAdopt<Small>::value);
+    }
 }
 
-void Benchmark() {
-    using namespace std;
-    try {
-        const size_t NUM = 10;
-        C c;
-        {
-            cerr << "std::vector:"sv << endl;
-            C::Reset();
-            vector<C> v(NUM);
-            Dump();
-            v.push_back(c);
+void Test12() {
+    const size_t SIZE = 10;
+    const size_t COUNT = 5;
+    const int ID = 42;
+    {
+        const Vector<int> v{ 1, 2, 3 };
+        assert(v.Size() == 3);
+        assert(v.Capacity() == 3);
+        assert(v[2] == 3);
+
+        std::istringstream input("4 5 6 7");
+        const Vector<int> from_stream(std::istream_iterator<int>(input), std::istream_iterator<int>{});
+        assert(from_stream.Size() == 4);
+        assert(from_stream[3] == 7);
+    }
+    {
+        Obj::ResetCounters();
+        const std::vector<Obj> source(COUNT);
+        Vector<Obj> v(SIZE);
+        v.Insert(v.cbegin() + 1, source.begin(), source.end());
+        //  :      ,   
+        assert(v.Size() == SIZE + COUNT);
+        assert(v.Capacity() == SIZE * 2);
+        assert(Obj::num_moved == static_cast<int>(SIZE));
+        assert(Obj::num_copied == static_cast<int>(COUNT));
+
+        //    :    
+        Obj::ResetCounters();
+        const size_t tail = v.Size() - 2;
+        v.Insert(v.cbegin() + 2, source.begin(), source.begin() + 2);
+        assert(v.Capacity() == SIZE * 2);
+        assert(Obj::num_moved + Obj::num_move_assigned == static_cast<int>(tail));
+        assert(Obj::num_copied + Obj::num_assigned == 2);
+
+        Obj::ResetCounters();
+        const size_t short_tail = 1;
+        v.Insert(v.cend() - short_tail, source.begin(), source.begin() + 2);
+        assert(v.Size() == SIZE + COUNT + 4);
+        assert(Obj::num_moved == static_cast<int>(short_tail));
+        assert(Obj::num_copied + Obj::num_assigned == 2);
+        assert(Obj::num_move_assigned == 0);
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        std::vector<Obj> source(COUNT);
+        source[COUNT - 1].throw_on_copy = true;
+        try {
+            v.Insert(v.cbegin(), source.begin(), source.end());
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
         }
-        Dump();
+        assert(v.Size() == SIZE);
+        assert(v.Capacity() == SIZE);
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(SIZE + COUNT));
+    }
+    {
+        Vector<int> v{ 1, 2, 3 };
+        v.Insert(v.cbegin() + 1, COUNT, v[2]);
+        assert(v.Size() == 3 + COUNT);
+        assert(v[1] == 3 && v[COUNT] == 3);
+        assert(v[COUNT + 1] == 2);
+
+        v.Insert(v.cbegin(), { 7, 8 });
+        assert(v[0] == 7 && v[1] == 8 && v[2] == 1);
+
+        std::istringstream input("9 10");
+        v.Insert(v.cbegin() + 1, std::istream_iterator<int>(input), std::istream_iterator<int>{});
+        assert(v[1] == 9 && v[2] == 10 && v[3] == 8);
+
+        const int tail[] = { ID, ID + 1 };
+        v.Append(tail);
+        assert(v[v.Size() - 2] == ID);
+        assert(v[v.Size() - 1] == ID + 1);
     }
-    catch (...) {
+    {
+        Vector<std::string> v;
+        std::vector<std::string> words{ "alpha", "beta", "gamma" };
+        v.Append(std::move(words));
+        assert(v.Size() == 3);
+        assert(v[1] == "beta");
+        assert(words[1].empty());
     }
-    try {
-        const size_t NUM = 10;
-        C c;
-        {
-            cerr << "Vector:"sv << endl;
-            C::Reset();
-            Vector<C> v(NUM);
-            Dump();
-            v.PushBack(c);
+    {
+        Relocatable::ResetCounters();
+        Vector<Relocatable> v;
+        v.Reserve(SIZE);
+        v.EmplaceBack(0);
+        v.EmplaceBack(1);
+        Vector<Relocatable> other;
+        other.EmplaceBack(2);
+        other.EmplaceBack(3);
+        v.Insert(v.cbegin() + 1, std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+        assert(*v[0].id == 0 && *v[1].id == 2 && *v[2].id == 3 && *v[3].id == 1);
+        //   ,    
+        assert(Relocatable::num_moved == 2);
+    }
+}
+
+void Test13() {
+    const size_t SIZE = 10;
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i].id = static_cast<int>(i);
+        }
+        auto pos = v.Erase(v.cbegin() + 2, v.cbegin() + 5);
+        assert(pos == v.begin() + 2);
+        assert(v.Size() == SIZE - 3);
+        assert(v.Capacity() == SIZE);
+        assert(v[2].id == 5);
+        assert(Obj::num_move_assigned == static_cast<int>(SIZE - 5));
+        assert(Obj::num_destroyed == 3);
+
+        assert(v.Erase(v.cbegin(), v.cbegin()) == v.begin());
+        assert(v.Size() == SIZE - 3);
+        v.Erase(v.cbegin(), v.cend());
+        assert(v.Size() == 0);
+        assert(Obj::GetAliveObjectCount() == 0);
+    }
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i].id = static_cast<int>(i);
+        }
+        const size_t removed = EraseIf(v, [](const Obj& obj) {
+            return obj.id % 2 == 0;
+        });
+        assert(removed == SIZE / 2);
+        assert(v.Size() == SIZE / 2);
+        assert(v[0].id == 1 && v[SIZE / 2 - 1].id == static_cast<int>(SIZE - 1));
+        //        
+        assert(Obj::num_move_assigned == static_cast<int>(SIZE / 2));
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(SIZE / 2));
+    }
+    {
+        Vector<int> v{ 1, 2, 1, 3, 1 };
+        assert(Erase(v, 1) == 3);
+        assert(v.Size() == 2);
+        assert(v[0] == 2 && v[1] == 3);
+        assert(Erase(v, 4) == 0);
+    }
+    {
+        Relocatable::ResetCounters();
+        Vector<Relocatable> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        v.Erase(v.cbegin() + 1);
+        assert(EraseIf(v, [](const Relocatable& r) {
+            return *r.id > 5;
+        }) == 4);
+        assert(v.Size() == SIZE - 5);
+        assert(*v[0].id == 0 && *v[1].id == 2 && *v[v.Size() - 1].id == 5);
+        assert(Relocatable::num_moved == 0);
+        assert(Relocatable::num_destroyed == 5);
+
+        try {
+            EraseIf(v, [](const Relocatable& r) {
+                if (*r.id == 4) {
+                    throw std::runtime_error("Oops");
+                }
+                return *r.id == 2;
+            });
+            assert(false && "Exception is expected");
         }
-        Dump();
+        catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == SIZE - 6);
+        assert(*v[0].id == 0 && *v[1].id == 3 && *v[2].id == 4 && *v[3].id == 5);
     }
-    catch (...) {
+    //        ,    
+    // ("  k ")  
+    {
+        Relocatable::ResetCounters();
+        Vector<Relocatable> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        size_t calls = 0;
+        size_t matches_left = 2;
+        assert(EraseIf(v, [&calls, &matches_left](const Relocatable& r) {
+            ++calls;
+            if (*r.id % 2 == 1 && matches_left > 0) {
+                --matches_left;
+                return true;
+            }
+            return false;
+        }) == 2);
+        assert(calls == SIZE);
+        assert(v.Size() == SIZE - 2);
+        assert(*v[0].id == 0 && *v[1].id == 2 && *v[2].id == 4 && *v[3].id == 5);
+        assert(Relocatable::num_moved == 0);
+        assert(Relocatable::num_destroyed == 2);
+    }
+}
+
+void Test14() {
+    const size_t SIZE = 100;
+    const int MAGIC = 42;
+    {
+        Vector<int> v(SIZE, DEFAULT_INIT);
+        assert(v.Size() == SIZE);
+        assert(v.Capacity() == SIZE);
+        std::fill(v.begin(), v.end(), MAGIC);
+        v.ResizeDefaultInit(SIZE * 2);
+        assert(v.Size() == SIZE * 2);
+        assert(v[SIZE - 1] == MAGIC);
+        v.ResizeDefaultInit(SIZE / 2);
+        assert(v.Size() == SIZE / 2);
+        assert(v.Capacity() == SIZE * 2);
+    }
+    {
+        Obj::ResetCounters();
+        //          
+        Vector<Obj> v(SIZE, DEFAULT_INIT);
+        v.ResizeDefaultInit(SIZE + 1);
+        assert(Obj::num_default_constructed == static_cast<int>(SIZE + 1));
+        assert(Obj::num_moved == static_cast<int>(SIZE));
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    {
+        Vector<char> v;
+        v.PushBack('>');
+        const std::string payload = "decoded payload";
+        v.ResizeAndOverwrite(SIZE, [&payload](char* data, size_t count) {
+            assert(count == SIZE);
+            assert(data[0] == '>');
+            return static_cast<size_t>(std::copy(payload.begin(), payload.end(), data + 1) - data);
+        });
+        assert(v.Size() == payload.size() + 1);
+        assert(v.Capacity() == SIZE);
+        assert(std::string(v.begin(), v.end()) == ">" + payload);
+    }
+}
+
+void Test15() {
+    const size_t SIZE = 100;
+    {
+        Obj::ResetCounters();
+        Vector<Obj, std::allocator<Obj>, DoublingGrowth, InstanceStats> v;
+        size_t allocations = 0;
+        size_t relocated = 0;
+        for (size_t i = 0; i < SIZE; ++i) {
+            if (v.Size() == v.Capacity()) {
+                ++allocations;
+                relocated += v.Size();
+            }
+            v.PushBack(Obj(static_cast<int>(i)));
+        }
+        const VectorStats& stats = v.GetStats().Get();
+        assert(stats.allocations == allocations);
+        assert(stats.reallocations == allocations - 1);
+        assert(stats.relocated_moved == relocated);
+        assert(stats.relocated_moved + SIZE == static_cast<size_t>(Obj::num_moved));
+        assert(stats.relocated_bytewise == 0 && stats.relocated_copied == 0);
+        assert(stats.peak_capacity == v.Capacity());
+
+        //      
+        auto copy = v;
+        assert(copy.GetStats().Get().allocations == 1);
+        assert(copy.GetStats().Get().reallocations == 0);
+    }
+    {
+        Vector<int, std::allocator<int>, DoublingGrowth, InstanceStats> v(SIZE);
+        v.Reserve(SIZE * 2);
+        assert(v.GetStats().Get().allocations == 2);
+        assert(v.GetStats().Get().relocated_bytewise == SIZE);
+        assert(v.GetStats().Get().bytes_allocated == SIZE * 3 * sizeof(int));
+    }
+    {
+        Vector<int, std::allocator<int>, DoublingGrowth, TaggedStats<ParserTag>> a(SIZE);
+        Vector<int, std::allocator<int>, DoublingGrowth, TaggedStats<ParserTag>> b;
+        b.Reserve(SIZE * 2);
+        assert(TaggedStats<ParserTag>::Get().allocations == 2);
+        assert(TaggedStats<ParserTag>::Get().peak_capacity == SIZE * 2);
+
+        std::ostringstream out;
+        StatsRegistry::Export(out);
+        assert(out.str().find("parser allocations=2 ") != std::string::npos);
+    }
+    //       
+#if !VECTOR_HARDENED
+    static_assert(sizeof(Vector<int>) == sizeof(int*) + 2 * sizeof(size_t));
+#endif
+}
+
+void Test16() {
+    const size_t SIZE = 1000;
+    {
+        Obj::ResetCounters();
+        Vector<Obj> v(SIZE);
+        v.Resize(10);
+        assert(v.Capacity() == SIZE);
+        v.ShrinkToFit();
+        assert(v.Capacity() == 10 && v.Size() == 10);
+        assert(Obj::GetAliveObjectCount() == 10);
+        v.Clear();
+        assert(v.Size() == 0 && v.Capacity() == 10);
+        assert(Obj::GetAliveObjectCount() == 0);
+        v.ShrinkToFit();
+        assert(v.Capacity() == 0 && v.Data() == nullptr);
+    }
+    {
+        using ShrinkingVector = Vector<int, std::allocator<int>, ShrinkingGrowth<>, InstanceStats>;
+        ShrinkingVector v(SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i] = static_cast<int>(i);
+        }
+        //  ,      
+        v.Resize(SIZE / 4);
+        assert(v.Capacity() == SIZE);
+        v.PopBack();
+        assert(v.Capacity() == (SIZE / 4 - 1) * 2);
+        assert(v[SIZE / 4 - 2] == static_cast<int>(SIZE / 4 - 2));
+
+        //        
+        const size_t allocations = v.GetStats().Get().allocations;
+        for (int i = 0; i < 100; ++i) {
+            v.PushBack(i);
+            v.PopBack();
+            v.PopBack();
+            v.PushBack(i);
+        }
+        assert(v.GetStats().Get().allocations == allocations);
+
+        // Erase     
+        const size_t capacity = v.Capacity();
+        auto it = v.Erase(v.begin() + 1, v.end() - 1);
+        assert(v.Capacity() < capacity);
+        assert(v.Size() == 2 && it == v.begin() + 1);
+        assert(v[0] == 0 && *it == 99);
+
+        //       
+        v.Clear();
+        v.Resize(SIZE);
+        assert(EraseIf(v, [](int) { return true; }) == SIZE);
+        assert(v.Capacity() == MinInitialCapacity(sizeof(int)));
+    }
+    {
+        SmallVector<int, 8, ShrinkingGrowth<>> v;
+        v.Resize(SIZE);
+        assert(!v.IsInline());
+        v.Resize(3);
+        assert(v.IsInline() && v.Capacity() == 8);
+        v.PopBack();
+        assert(v.IsInline());
+    }
+    {
+        SmallVector<int, 8> v(SIZE);
+        v.Resize(5);
+        v.ShrinkToFit();
+        assert(v.IsInline() && v.Size() == 5);
+        v.ShrinkToFit();
+        assert(v.IsInline() && v.Capacity() == 8);
+    }
+}
+
+void Test17() {
+    const size_t SIZE = 1 << 18;
+    LargePageOptions options;
+    options.mmap_threshold = 64 * 1024;
+    {
+        //   ,   mremap  
+        Vector<int, LargePageAllocator<int>> v{ LargePageAllocator<int>(options) };
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<int>(i));
+        }
+        for (size_t i = 0; i < SIZE; ++i) {
+            assert(v[i] == static_cast<int>(i));
+        }
+        v.Resize(10);
+        v.ShrinkToFit();
+        assert(v.Capacity() == 10 && v[9] == 9);
+    }
+    {
+        //     MAP_HUGETLB    
+        LargePageOptions explicit_pages = options;
+        explicit_pages.huge_pages = LargePageOptions::HugePages::EXPLICIT;
+        explicit_pages.numa = LargePageOptions::Numa::INTERLEAVE;
+        explicit_pages.nodes = 1;
+        Vector<std::string, LargePageAllocator<std::string>> v(SIZE / 16, LargePageAllocator<std::string>(explicit_pages));
+        v[SIZE / 16 - 1] = "last";
+        v.Reserve(SIZE / 4);
+        assert(v[SIZE / 16 - 1] == "last");
+
+        Vector<std::string, LargePageAllocator<std::string>> copy(v, LargePageAllocator<std::string>(options));
+        assert(copy.GetAllocator() != v.GetAllocator());
+        v = copy;
+        assert(v.GetAllocator().GetOptions() == explicit_pages);
+        assert(v.Size() == SIZE / 16 && v[SIZE / 16 - 1] == "last");
+    }
+}
+
+void Test18() {
+    const size_t SIZE = 1000;
+    const auto is_aligned = [](const void* p, size_t alignment) {
+        return reinterpret_cast<std::uintptr_t>(p) % alignment == 0;
+    };
+    {
+        //  : std::allocator   operator new
+        struct alignas(128) Block {
+            float values[32];
+        };
+        static_assert(alignof(Block) > __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+        Vector<Block> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack();
+            assert(is_aligned(v.Data(), alignof(Block)));
+        }
+        v.Insert(v.begin(), Block{});
+        assert(is_aligned(v.Data(), alignof(Block)));
+        Pool pool;
+        Vector<Block, PoolAllocator<Block>> pooled(10, PoolAllocator<Block>(pool));
+        assert(is_aligned(pooled.Data(), alignof(Block)));
+    }
+    {
+        using CacheLineAllocator = AlignedAllocator<float, CACHE_LINE_SIZE>;
+        Vector<float, CacheLineAllocator> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.PushBack(static_cast<float>(i));
+            assert(is_aligned(v.Data(), CACHE_LINE_SIZE));
+        }
+        const Vector<float, CacheLineAllocator> copy = v;
+        assert(is_aligned(copy.Data(), CACHE_LINE_SIZE));
+        assert(copy[SIZE - 1] == static_cast<float>(SIZE - 1));
+
+        using Rebound = std::allocator_traits<CacheLineAllocator>::rebind_alloc<double>;
+        static_assert(std::is_same_v<Rebound, AlignedAllocator<double, CACHE_LINE_SIZE>>);
+    }
+}
+
+void Test19() {
+    //         
+    for (size_t size : { 1, 7, 63, 64, 65, 1000, 4099 }) {
+        Vector<int> ints(size);
+        Vector<float> floats(size);
+        Vector<unsigned char> bytes(size);
+        for (size_t i = 0; i < size; ++i) {
+            ints[i] = static_cast<int>(i * 7919 % 1009) - 500;
+            floats[i] = static_cast<float>(i % 17) * 0.5f;
+            bytes[i] = static_cast<unsigned char>(i * 31);
+        }
+        assert(Find(ints, ints[size - 1]) == std::find(ints.Data(), ints.Data() + size, ints[size - 1]));
+        assert(Find(ints, 100000) == ints.Data() + size);
+        assert(Count(ints, ints[0]) == static_cast<size_t>(std::count(ints.begin(), ints.end(), ints[0])));
+        assert(Sum(ints) == std::accumulate(ints.begin(), ints.end(), 0LL));
+        assert(Sum(bytes) == std::accumulate(bytes.begin(), bytes.end(), 0ULL));
+        //         
+        assert(Sum(floats) == std::accumulate(floats.begin(), floats.end(), 0.0f));
+        assert(Dot(ints, ints) == std::inner_product(ints.begin(), ints.end(), ints.begin(), 0LL));
+
+        const auto [min, max] = MinMax(ints);
+        const auto expected = std::minmax_element(ints.begin(), ints.end());
+        assert(min == *expected.first && max == *expected.second);
+
+        Vector<double> doubled;
+        Transform(ints, doubled, [](int x) {
+            return x * 2.0;
+        });
+        assert(doubled.Size() == size && doubled[size - 1] == ints[size - 1] * 2.0);
+        Transform(ints, [](int x) {
+            return -x;
+        });
+        assert(ints[size - 1] == -static_cast<int>(doubled[size - 1] / 2));
+
+        Vector<int> copy = ints;
+        assert(Equal(ints, copy));
+        copy[size - 1] += 1;
+        assert(!Equal(ints, copy));
+        Fill(copy, 3);
+        assert(Count(copy, 3) == size);
+    }
+    {
+        Vector<double> v{ 0.0, 1.0 };
+        Vector<double> w{ -0.0, 1.0 };
+        assert(Equal(v, w));
+        w[1] = std::numeric_limits<double>::quiet_NaN();
+        assert(!Equal(w, w));
+    }
+}
+
+void Test20() {
+    const size_t SIZE = 1000;
+    //    ,         
+    const ParallelPolicy policy{ 4, 1 };
+    ThreadSafeObj::ResetCounters();
+    {
+        Vector<ThreadSafeObj> v(policy, SIZE);
+        assert(v.Size() == SIZE && ThreadSafeObj::num_alive == static_cast<int>(SIZE));
+        for (size_t i = 0; i < SIZE; ++i) {
+            v[i].id = static_cast<int>(i);
+        }
+        Vector<ThreadSafeObj> copy(policy, v);
+        assert(copy.Size() == SIZE && copy[SIZE - 1].id == static_cast<int>(SIZE - 1));
+
+        //       ,   -  
+        const ThreadSafeObj* buffer = copy.Data();
+        copy[0].id = -1;
+        copy.Assign(policy, v);
+        assert(copy.Data() == buffer && copy[0].id == 0 && copy[SIZE - 1].id == static_cast<int>(SIZE - 1));
+        Vector<ThreadSafeObj> small(1);
+        small.Assign(policy, v);
+        assert(small.Size() == SIZE && small.Capacity() >= SIZE && small[SIZE / 2].id == static_cast<int>(SIZE / 2));
+        small.Assign(policy, small);
+        assert(small.Size() == SIZE && ThreadSafeObj::num_alive == static_cast<int>(SIZE * 3));
+        small.Clear();
+
+        v.Resize(policy, SIZE * 3);
+        assert(v.Size() == SIZE * 3 && v[SIZE - 1].id == static_cast<int>(SIZE - 1));
+        assert(ThreadSafeObj::num_alive == static_cast<int>(SIZE * 4));
+        v.Resize(policy, SIZE);
+        assert(ThreadSafeObj::num_alive == static_cast<int>(SIZE * 2));
+    }
+    assert(ThreadSafeObj::num_alive == 0);
+    {
+        //     :    
+        ThreadSafeObj::throw_countdown = SIZE / 2;
+        try {
+            Vector<ThreadSafeObj> v(policy, SIZE);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(ThreadSafeObj::num_alive == 0);
+    }
+    {
+        Vector<ThreadSafeObj> v(policy, SIZE);
+        v[SIZE * 3 / 4].throw_on_copy = true;
+        try {
+            Vector<ThreadSafeObj> copy(policy, v);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(ThreadSafeObj::num_alive == static_cast<int>(SIZE));
+
+        //          
+        Vector<ThreadSafeObj> dst(2);
+        try {
+            dst.Assign(policy, v);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(dst.Size() == 0 && ThreadSafeObj::num_alive == static_cast<int>(SIZE));
+
+        //  Resize   
+        ThreadSafeObj::throw_countdown = SIZE / 3;
+        v[SIZE * 3 / 4].id = 42;
+        try {
+            v.Resize(policy, SIZE * 2);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == SIZE && v[SIZE * 3 / 4].id == 42);
+        assert(ThreadSafeObj::num_alive == static_cast<int>(SIZE));
+    }
+    {
+        Vector<int> v(PARALLEL, SIZE * SIZE);
+        assert(Count(v, 0) == SIZE * SIZE);
+    }
+}
+
+void Test21() {
+    const size_t SIZE = 1000;
+    {
+        SoaVector<float, double, std::string> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            auto [x, y, name] = v.EmplaceBack(static_cast<float>(i), i * 0.5, std::to_string(i));
+            assert(x == static_cast<float>(i) && y == i * 0.5 && name == std::to_string(i));
+        }
+        assert(v.Size() == SIZE && v.Capacity() >= SIZE);
+
+        //     ,   
+        auto [x, y, name] = v[10];
+        x = -1.0f;
+        name = "ten";
+        assert(v.Column<0>()[10] == -1.0f && std::get<2>(v[10]) == "ten");
+        assert(simd::Sum(v.Column<1>().begin(), v.Column<1>().end()) == (SIZE - 1) * SIZE / 4.0);
+        (void)y;
+
+        v.Erase(0, 10);
+        assert(v.Size() == SIZE - 10 && std::get<2>(v[0]) == "ten" && std::get<1>(v[0]) == 5.0);
+        v.Erase(v.Size() - 1);
+        v.PopBack();
+        assert(v.Size() == SIZE - 12 && std::get<2>(v[v.Size() - 1]) == std::to_string(SIZE - 3));
+
+        const auto copy = v;
+        assert(copy.Size() == v.Size() && std::get<2>(copy[0]) == "ten");
+        auto moved = std::move(v);
+        assert(moved.Size() == copy.Size() && v.Size() == 0);
+        moved.Clear();
+        assert(moved.Size() == 0 && moved.Capacity() >= SIZE);
+
+        //       
+        SoaVector<std::string, int> names;
+        names.EmplaceBack(std::string("first"), 1);
+        while (names.Size() < names.Capacity()) {
+            names.EmplaceBack(std::get<0>(names[0]), 0);
+        }
+        names.EmplaceBack(std::get<0>(names[0]), 2);
+        assert(std::get<0>(names[names.Size() - 1]) == "first");
+    }
+    ThreadSafeObj::ResetCounters();
+    {
+        // ,    :    
+        SoaVector<int, ThreadSafeObj> v(SIZE);
+        std::get<1>(v[SIZE / 2]).throw_on_copy = true;
+        std::get<0>(v[SIZE / 2]) = 42;
+        try {
+            v.Reserve(SIZE * 2);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(v.Capacity() == SIZE && std::get<0>(v[SIZE / 2]) == 42);
+        assert(ThreadSafeObj::num_alive == static_cast<int>(SIZE));
+        std::get<1>(v[SIZE / 2]).throw_on_copy = false;
+        v.Reserve(SIZE * 2);
+        assert(v.Capacity() == SIZE * 2 && std::get<0>(v[SIZE / 2]) == 42);
+        assert(ThreadSafeObj::num_alive == static_cast<int>(SIZE));
+
+        ThreadSafeObj::throw_countdown = SIZE / 2;
+        try {
+            SoaVector<int, ThreadSafeObj> failed(SIZE);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(ThreadSafeObj::num_alive == static_cast<int>(SIZE));
+    }
+    {
+        //      Erase      
+        SoaVector<std::string, ThreadSafeObj> v(SIZE);
+        for (size_t i = 0; i < SIZE; ++i) {
+            std::get<0>(v[i]) = std::string(100, 'a' + i % 26);
+        }
+        std::get<1>(v[SIZE / 2]).throw_on_copy = true;
+        try {
+            v.Erase(0, 1);
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == SIZE && ThreadSafeObj::num_alive == static_cast<int>(SIZE));
+        std::get<1>(v[SIZE / 2]).throw_on_copy = false;
+        v.Erase(0, 1);
+        assert(v.Size() == SIZE - 1 && ThreadSafeObj::num_alive == static_cast<int>(SIZE - 1));
+    }
+    assert(ThreadSafeObj::num_alive == 0);
+}
+
+void Test22() {
+    const size_t SIZE = 10000;
+    {
+        //  :        
+        struct Pinned {
+            explicit Pinned(size_t id)
+                : id(id) {
+            }
+            Pinned(const Pinned&) = delete;
+            Pinned& operator=(const Pinned&) = delete;
+
+            size_t id;
+        };
+        SegmentedVector<Pinned> v;
+        const Pinned* first = &v.EmplaceBack(0);
+        Vector<const Pinned*> addresses;
+        for (size_t i = 1; i < SIZE; ++i) {
+            addresses.PushBack(&v.EmplaceBack(i));
+        }
+        assert(v.Size() == SIZE && &v[0] == first && first->id == 0);
+        for (size_t i = 1; i < SIZE; ++i) {
+            assert(&v[i] == addresses[i - 1] && v[i].id == i);
+        }
+        assert(v.BlockCount() == (SIZE + v.SEGMENT_SIZE - 1) / v.SEGMENT_SIZE);
+    }
+    Obj::ResetCounters();
+    {
+        SegmentedVector<Obj, 64> v;
+        for (size_t i = 0; i < SIZE; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        assert(Obj::num_moved == 0 && Obj::num_copied == 0);
+        const auto copy = v;
+        assert(copy.Size() == SIZE && copy[SIZE - 1].id == static_cast<int>(SIZE - 1));
+
+        for (size_t i = 0; i < 100; ++i) {
+            v.PopBack();
+        }
+        assert(v.BlockCount() == (SIZE + 63) / 64);
+        v.ShrinkToFit();
+        assert(v.BlockCount() == (SIZE - 100 + 63) / 64 && v.Size() == SIZE - 100);
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(SIZE * 2 - 100));
+
+        Vector<Obj> flat = std::move(v).ToVector();
+        assert(v.Size() == 0 && v.BlockCount() == 0);
+        assert(flat.Size() == SIZE - 100 && flat.Capacity() == SIZE - 100);
+        assert(flat[SIZE - 101].id == static_cast<int>(SIZE - 101));
+        assert(Obj::num_moved == static_cast<int>(SIZE - 100) && Obj::num_copied == static_cast<int>(SIZE));
+        assert(Obj::GetAliveObjectCount() == static_cast<int>(SIZE * 2 - 100));
+    }
+    assert(Obj::GetAliveObjectCount() == 0);
+    ThreadSafeObj::ResetCounters();
+    {
+        //     ,       
+        SegmentedVector<ThreadSafeObj, 16> v;
+        for (size_t i = 0; i < 100; ++i) {
+            v.EmplaceBack().id = static_cast<int>(i);
+        }
+        v[50].throw_on_copy = true;
+        try {
+            Vector<ThreadSafeObj> flat = std::move(v).ToVector();
+            assert(false && "Exception is expected");
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(v.Size() == 100 && v[99].id == 99 && ThreadSafeObj::num_alive == 100);
+        v[50].throw_on_copy = false;
+        Vector<ThreadSafeObj> flat = std::move(v).ToVector();
+        assert(flat.Size() == 100 && flat[99].id == 99 && ThreadSafeObj::num_alive == 100);
+    }
+    assert(ThreadSafeObj::num_alive == 0);
+}
+
+void Test23() {
+    const size_t NUM_THREADS = 8;
+    const size_t PER_THREAD = 10000;
+    {
+        ConcurrentVector<size_t> v;
+        std::atomic<bool> done = false;
+        //      
+        std::thread reader([&v, &done] {
+            while (!done) {
+                const size_t size = v.Size();
+                for (size_t i = 0; i < size; i += 97) {
+                    if (const size_t* value = v.TryGet(i)) {
+                        assert(*value % PER_THREAD < PER_THREAD);
+                    }
+                }
+            }
+        });
+        Vector<std::thread> writers;
+        writers.Reserve(NUM_THREADS);
+        for (size_t t = 0; t < NUM_THREADS; ++t) {
+            writers.EmplaceBack([&v, t] {
+                for (size_t i = 0; i < PER_THREAD; ++i) {
+                    const size_t index = v.EmplaceBack(t * PER_THREAD + i);
+                    assert(v[index] == t * PER_THREAD + i);
+                }
+            });
+        }
+        for (std::thread& writer : writers) {
+            writer.join();
+        }
+        done = true;
+        reader.join();
+        assert(v.Size() == NUM_THREADS * PER_THREAD);
+
+        Vector<size_t> frozen = v.Freeze();
+        assert(v.Size() == 0 && frozen.Size() == NUM_THREADS * PER_THREAD);
+        std::sort(frozen.begin(), frozen.end());
+        for (size_t i = 0; i < frozen.Size(); ++i) {
+            assert(frozen[i] == i);
+        }
+    }
+    ThreadSafeObj::ResetCounters();
+    {
+        // ,    ,  
+        ConcurrentVector<ThreadSafeObj, 4> v;
+        ThreadSafeObj::throw_countdown = 3;
+        for (int i = 0; i < 10; ++i) {
+            try {
+                v[v.EmplaceBack()].id = i;
+            }
+            catch (const std::runtime_error&) {
+                assert(i == 2);
+            }
+        }
+        assert(v.Size() == 10 && v.TryGet(2) == nullptr && v[9].id == 9);
+        const Vector<ThreadSafeObj> frozen = v.Freeze();
+        assert(frozen.Size() == 9 && frozen[2].id == 3);
+        assert(ThreadSafeObj::num_alive == 9);
+    }
+    assert(ThreadSafeObj::num_alive == 0);
+}
+
+void Test24() {
+    BufferRecycler& recycler = BufferRecycler::Local();
+    recycler.Trim();
+    //          
+    {
+        const void* first_buffer = nullptr;
+        {
+            Vector<int, RecyclingAllocator<int>> v;
+            v.Reserve(100);
+            first_buffer = v.Data();
+        }
+        assert(recycler.CachedBytes() == BufferRecycler::BufferBytes(100 * sizeof(int)));
+        const size_t hits = recycler.Hits();
+        Vector<int, RecyclingAllocator<int>> v;
+        v.Reserve(120);
+        assert(v.Data() == first_buffer);
+        assert(recycler.Hits() == hits + 1);
+        assert(recycler.CachedBytes() == 0);
+    }
+    // Reset    ,  Clear    
+    {
+        recycler.Trim();
+        Vector<int, RecyclingAllocator<int>> v(1000);
+        v.Clear();
+        assert(v.Capacity() == 1000 && recycler.CachedBytes() == 0);
+        v.Reset();
+        assert(v.Capacity() == 0 && v.Size() == 0);
+        assert(recycler.CachedBytes() == BufferRecycler::BufferBytes(1000 * sizeof(int)));
+        v.PushBack(1);
+        assert(v.Size() == 1 && v[0] == 1);
+    }
+    //  
+    {
+        recycler.Trim();
+        const BufferRecycler::Limits old_limits = recycler.GetLimits();
+        BufferRecycler::Limits limits;
+        limits.max_buffer_bytes = 1024;
+        limits.max_cached_bytes = 4096;
+        limits.max_buffers_per_bucket = 2;
+        recycler.SetLimits(limits);
+        {
+            Vector<Vector<char, RecyclingAllocator<char>>> buffers;
+            for (int i = 0; i < 4; ++i) {
+                buffers.EmplaceBack().Reserve(1000);
+            }
+            buffers.EmplaceBack().Reserve(2000);
+        }
+        //    1 ,       
+        assert(recycler.CachedBytes() == 2048);
+        {
+            Vector<Vector<char, RecyclingAllocator<char>>> buffers;
+            for (int i = 0; i < 8; ++i) {
+                buffers.EmplaceBack().Reserve(500);
+            }
+        }
+        //  512 :  ,    4    
+        assert(recycler.CachedBytes() == 3072);
+        recycler.SetLimits(old_limits);
+        recycler.Trim();
+        assert(recycler.CachedBytes() == 0);
+    }
+    //     
+    {
+        recycler.Trim();
+        std::thread([] {
+            Vector<int, RecyclingAllocator<int>> v(10);
+            v.Reset();
+            assert(BufferRecycler::Local().CachedBytes() != 0);
+        }).join();
+        assert(recycler.CachedBytes() == 0);
+    }
+    //     ,    ,    
+    //      
+    {
+        std::thread([] {
+            thread_local Vector<int, RecyclingAllocator<int>> late;
+            late.Resize(100);
+            assert(BufferRecycler::TryLocal() == &BufferRecycler::Local());
+        }).join();
+    }
+}
+
+void Test25() {
+    //           
+    {
+        Vector<int> src(100);
+        std::iota(src.begin(), src.end(), 0);
+        Vector<int> dst(200);
+        const int* buffer = dst.Data();
+        dst = src;
+        assert(dst.Data() == buffer && dst.Capacity() == 200);
+        assert(dst.Size() == 100 && Equal(dst, src));
+        Vector<int> empty;
+        dst = empty;
+        assert(dst.Size() == 0 && dst.Capacity() == 200);
+    }
+    // Assign      
+    {
+        Vector<std::string> v(10);
+        const std::string* buffer = v.Data();
+        const std::string words[] = { "alpha", "beta", "gamma" };
+        v.Assign(std::begin(words), std::end(words));
+        assert(v.Size() == 3 && v[2] == "gamma" && v.Data() == buffer);
+        std::istringstream input("1 2 3 4 5");
+        Vector<int> numbers{ 9, 9 };
+        numbers.Assign(std::istream_iterator<int>(input), std::istream_iterator<int>());
+        assert(numbers.Size() == 5 && numbers[0] == 1 && numbers[4] == 5);
+        numbers.Assign({ 7, 8 });
+        assert(numbers.Size() == 2 && numbers[1] == 8);
+    }
+    // Assign(count, value)     ,      
+    {
+        Vector<std::string> v{ "a", "b", "c" };
+        v.Assign(2, v[2]);
+        assert(v.Size() == 2 && v[0] == "c" && v[1] == "c");
+        v.Assign(100, v[1]);
+        assert(v.Size() == 100 && v[99] == "c");
+    }
+    //       ,      :
+    //    
+    {
+        Obj::ResetCounters();
+        Vector<Obj> src(10);
+        src[5].throw_on_copy = true;
+        Vector<Obj> dst(3);
+        try {
+            dst = src;
+            assert(false);
+        }
+        catch (const std::runtime_error&) {
+        }
+        assert(dst.Size() == 0);
+        assert(Obj::GetAliveObjectCount() == 10);
+        src[5].throw_on_copy = false;
+        dst = src;
+        assert(dst.Size() == 10 && Obj::GetAliveObjectCount() == 20);
+    }
+    //     ,   
+    {
+        Arena arena1;
+        Arena arena2;
+        Vector<int, ArenaAllocator<int>> v1(50, ArenaAllocator<int>(arena1));
+        Vector<int, ArenaAllocator<int>> v2(5, ArenaAllocator<int>(arena2));
+        v2 = v1;
+        assert(&v2.GetAllocator().GetArena() == &arena2 && v2.Size() == 50 && v2[49] == 0);
+    }
+}
+
+void Test26() {
+    // Release  Adopt    
+    {
+        Vector<std::string> v{ "a", "b", "c" };
+        v.Reserve(10);
+        const std::string* data = v.Data();
+        const auto buffer = v.Release();
+        assert(v.Size() == 0 && v.Capacity() == 0);
+        assert(buffer.data == data && buffer.size == 3 && buffer.capacity == 10);
+        Vector<std::string> w{ "old" };
+        w.Adopt(buffer.data, buffer.size, buffer.capacity);
+        assert(w.Data() == data && w.Size() == 3 && w.Capacity() == 10 && w[2] == "c");
+        w.PushBack("d");
+        assert(w.Data() == data && w[3] == "d");
+    }
+    {
+        Vector<std::string> v{ "x", "y" };
+        auto buffer = v.Release();
+        //       
+        std::destroy_n(buffer.data, buffer.size);
+        auto alloc = v.GetAllocator();
+        std::allocator_traits<decltype(alloc)>::deallocate(alloc, buffer.data, buffer.capacity);
+    }
+    //        :     
+    {
+        int num_released = 0;
+        int* external = new int[8]{ 1, 2, 3 };
+        const auto release = [&num_released](int* p) {
+            ++num_released;
+            delete[] p;
+        };
+        {
+            Vector<int, ExternalBufferAllocator<int>> v;
+            v.Adopt(external, 3, 8, release);
+            assert(v.Data() == external && v.Size() == 3 && v[2] == 3);
+            for (int i = 4; i <= 8; ++i) {
+                v.PushBack(i);
+            }
+            assert(v.Data() == external && num_released == 0);
+            v.PushBack(9);
+            assert(v.Data() != external && num_released == 1);
+            assert(v.Size() == 9 && v[0] == 1 && v[8] == 9);
+            const Vector<int, ExternalBufferAllocator<int>> copy = v;
+            assert(copy.Size() == 9);
+        }
+        assert(num_released == 1);
+        int* another = new int[4]{ 5 };
+        {
+            Vector<int, ExternalBufferAllocator<int>> v;
+            v.Adopt(another, 1, 4, release);
+        }
+        assert(num_released == 2);
+    }
+    // View -   
+    {
+        Vector<int> v{ 1, 2, 3, 4, 5 };
+        const Span<int> view = v.View();
+        assert(view.Data() == v.Data() && view.Size() == 5);
+        view[0] = 10;
+        assert(v[0] == 10);
+        const Span<const int> tail = std::as_const(v).View().Subspan(3, 2);
+        assert(tail.Size() == 2 && tail[0] == 4 && tail[1] == 5);
+        const Span<const int> converted = view;
+        assert(std::accumulate(converted.begin(), converted.end(), 0) == 24);
+        assert(Vector<int>().View().Empty());
+    }
+}
+
+void Test27() {
+    struct Record {
+        int id;
+        double value;
+    };
+    const std::string path = (std::filesystem::temp_directory_path() / "advanced_vector_test27.bin").string();
+    std::filesystem::remove(path);
+    const size_t SIZE = 10000;
+    {
+        MappedVector<Record> records(path);
+        assert(records.Size() == 0 && records.Capacity() == 0 && !records.IsReadOnly());
+        for (size_t i = 0; i < SIZE / 2; ++i) {
+            records.PushBack({ static_cast<int>(i), i * 0.5 });
+        }
+        Vector<Record> tail;
+        for (size_t i = SIZE / 2; i < SIZE; ++i) {
+            tail.PushBack(Record{ static_cast<int>(i), i * 0.5 });
+        }
+        records.Append(tail.View());
+        // ,   ,   
+        while (records.Size() != records.Capacity()) {
+            records.EmplaceBack(records[0]);
+        }
+        records.EmplaceBack(records[1]);
+        assert(records[records.Size() - 1].id == 1);
+        records.Resize(SIZE);
+        records.Flush();
+    }
+    //        
+    {
+        MappedVector<Record> records(path);
+        assert(records.Size() == SIZE);
+        assert(records[SIZE - 1].id == SIZE - 1 && records[SIZE - 1].value == (SIZE - 1) * 0.5);
+        records.PopBack();
+        records.Resize(SIZE + 1);
+        assert(records[SIZE].id == 0 && records[SIZE].value == 0.0);
+        // Resize  ,     
+        while (records.Size() != records.Capacity()) {
+            records.Resize(records.Size() + 1);
+        }
+        const size_t capacity = records.Capacity();
+        records.Resize(capacity + 1);
+        assert(records.Capacity() >= capacity * 2);
+        records.Resize(SIZE + 1);
+        MappedVector<Record> moved = std::move(records);
+        assert(moved.Size() == SIZE + 1);
+        assert(records.Size() == 0 && records.Capacity() == 0 && records.Data() == nullptr);
+        assert(records.begin() == records.end() && records.View().Empty());
+    }
+    {
+        //         operator[]  View
+        MappedVector<Record> records(path, MappedMode::READ_ONLY);
+        const Record first = records[0];
+        assert(first.id == 0 && records.View()[SIZE - 2].id == static_cast<int>(SIZE - 2));
+    }
+    {
+        const MappedVector<Record> records(path, MappedMode::READ_ONLY);
+        assert(records.IsReadOnly() && records.Size() == SIZE + 1);
+        long long sum = 0;
+        for (const Record& record : records.View()) {
+            sum += record.id;
+        }
+        assert(sum == static_cast<long long>(SIZE - 1) * (SIZE - 2) / 2);
+    }
+    //        
+    try {
+        MappedVector<int64_t> wrong(path, MappedMode::READ_ONLY);
+        assert(false);
+    }
+    catch (const std::runtime_error&) {
+    }
+    std::filesystem::remove(path);
+    try {
+        MappedVector<Record> missing(path, MappedMode::READ_ONLY);
+        assert(false);
+    }
+    catch (const std::system_error& e) {
+        assert(e.code() == std::errc::no_such_file_or_directory);
+    }
+}
+
+void Test28() {
+    using namespace serialization;
+    //   :    
+    {
+        Vector<int> v(1000);
+        std::iota(v.begin(), v.end(), -500);
+        std::stringstream stream;
+        Serialize(stream, v);
+        assert(stream.str().size() == sizeof(Header) + v.Size() * sizeof(int));
+        Vector<int> restored{ 1, 2, 3 };
+        Deserialize(stream, restored);
+        assert(Equal(restored, v));
+        std::stringstream empty_stream;
+        Serialize(empty_stream, Vector<int>());
+        Deserialize(empty_stream, restored);
+        assert(restored.Size() == 0);
+    }
+    // :  ,    ,    
+    {
+        Vector<std::string> v;
+        for (int i = 0; i < 20000; ++i) {
+            v.PushBack(std::string(i % 17, 'a' + i % 26));
+        }
+        std::stringstream stream;
+        Serialize(stream, v, StringCodec());
+        Vector<std::string> restored;
+        Deserialize(stream, restored, StringCodec());
+        assert(restored.Size() == v.Size());
+        for (size_t i = 0; i < v.Size(); ++i) {
+            assert(restored[i] == v[i]);
+        }
+    }
+    //     
+    {
+        struct Entry {
+            int id;
+            std::string name;
+        };
+        struct EntryCodec {
+            void Encode(const Entry& entry, std::string& out) const {
+                BytewiseCodec<int>().Encode(entry.id, out);
+                StringCodec().Encode(entry.name, out);
+            }
+            Entry Decode(std::string_view& in) const {
+                const int id = BytewiseCodec<int>().Decode(in);
+                return Entry{ id, StringCodec().Decode(in) };
+            }
+        };
+        Vector<Entry> v;
+        v.PushBack(Entry{ 1, "one" });
+        v.PushBack(Entry{ 2, "two" });
+        std::stringstream stream;
+        Serialize(stream, v, EntryCodec());
+        Vector<Entry> restored;
+        Deserialize(stream, restored, EntryCodec());
+        assert(restored.Size() == 2 && restored[1].id == 2 && restored[1].name == "two");
+    }
+    //  ,    
+    {
+        std::stringstream stream;
+        Serialize(stream, Vector<int>(10));
+        const std::string bytes = stream.str();
+        const auto fails = [](const std::string& input, auto& target, auto... codec) {
+            std::istringstream in(input);
+            try {
+                Deserialize(in, target, codec...);
+            }
+            catch (const std::runtime_error&) {
+                return target.Size() == 0;
+            }
+            return false;
+        };
+        Vector<double> doubles;
+        assert(fails(bytes, doubles));
+        Vector<int> ints{ 1 };
+        assert(fails(bytes.substr(0, bytes.size() - 1), ints));
+        assert(fails("garbage", ints));
+        Vector<std::string> strings{ "x" };
+        assert(fails(bytes, strings, StringCodec()));
+        Vector<std::string> three;
+        three.Assign(3, "abc");
+        std::stringstream chunked;
+        Serialize(chunked, three, StringCodec());
+        assert(fails(chunked.str().substr(0, chunked.str().size() - 2), strings, StringCodec()));
+    }
+    //   , , :   
+    struct PipeBuf : std::streambuf {
+        explicit PipeBuf(std::string bytes)
+            : bytes(std::move(bytes)) {
+            setg(this->bytes.data(), this->bytes.data(), this->bytes.data() + this->bytes.size());
+        }
+        std::string bytes;
+    };
+    //           : std::runtime_error,
+    //     
+    {
+        const auto fails = [](const std::string& input, bool seekable, auto& target, auto... codec) {
+            std::istringstream seekable_in(input);
+            PipeBuf pipe(input);
+            std::istream pipe_in(&pipe);
+            try {
+                Deserialize(seekable ? static_cast<std::istream&>(seekable_in) : pipe_in, target, codec...);
+            }
+            catch (const std::runtime_error&) {
+                return target.Size() == 0;
+            }
+            return false;
+        };
+        const auto bytes_of = [](const auto& value) {
+            return std::string(reinterpret_cast<const char*>(&value), sizeof(value));
+        };
+        Vector<int> v(100000);
+        std::iota(v.begin(), v.end(), 0);
+        std::stringstream stream;
+        Serialize(stream, v);
+        const std::string bytes = stream.str();
+        const std::string truncated = bytes.substr(0, bytes.size() - 3);
+        std::string oversized = bytes;
+        Header header{};
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        header.count = uint64_t{ 1 } << 40;
+        oversized.replace(0, sizeof(header), bytes_of(header));
+        header.count = v.Size() + 1;
+        std::string slightly_oversized = bytes;
+        slightly_oversized.replace(0, sizeof(header), bytes_of(header));
+
+        const Header chunked_header{ MAGIC, VERSION, Format::CHUNKED, 0, 0, 1 };
+        const ChunkHeader huge_chunk{ 1, uint64_t{ 1 } << 40 };
+        const std::string huge_chunk_bytes = bytes_of(chunked_header) + bytes_of(huge_chunk) + "abc";
+        const Header many_header{ MAGIC, VERSION, Format::CHUNKED, 0, 0, uint64_t{ 1 } << 40 };
+        const std::string many_strings = bytes_of(many_header) + bytes_of(ChunkHeader{ 1, 8 }) + bytes_of(uint64_t{ 0 });
+
+        for (const bool seekable : { true, false }) {
+            Vector<int> ints{ 1 };
+            assert(fails(truncated, seekable, ints));
+            assert(fails(oversized, seekable, ints));
+            assert(fails(slightly_oversized, seekable, ints));
+            Vector<std::string> strings{ "x" };
+            assert(fails(huge_chunk_bytes, seekable, strings, StringCodec()));
+            assert(fails(many_strings, seekable, strings, StringCodec()));
+
+            PipeBuf pipe(bytes);
+            std::istream pipe_in(&pipe);
+            std::istringstream seekable_in(bytes);
+            Deserialize(seekable ? static_cast<std::istream&>(seekable_in) : pipe_in, ints);
+            assert(Equal(ints, v));
+        }
+    }
+}
+
+void Test29() {
+    //   :   ,     
+    {
+        Vector<Relocatable> v;
+        v.Reserve(10);
+        for (int i = 0; i < 5; ++i) {
+            v.EmplaceBack(i);
+        }
+        Relocatable::ResetCounters();
+        v.Emplace(v.begin() + 1, 100);
+        assert(Relocatable::num_moved == 0 && Relocatable::num_destroyed == 0);
+        assert(v.Size() == 6 && *v[1].id == 100 && *v[2].id == 1 && *v[5].id == 4);
+    }
+    // -   
+    {
+        Vector<int> v{ 0, 1, 2, 3, 4 };
+        v.Reserve(10);
+        v.Insert(v.begin(), v[3]);
+        v.Emplace(v.begin() + 2, v[5]);
+        const int expected[] = { 3, 0, 4, 1, 2, 3, 4 };
+        assert(v.Size() == 7 && std::equal(v.begin(), v.end(), std::begin(expected)));
+    }
+    //     :      
+    {
+        Vector<MoveCounter> v;
+        v.Reserve(10);
+        for (int i = 0; i < 5; ++i) {
+            v.EmplaceBack(i);
+        }
+        MoveCounter::ResetCounters();
+        v.Emplace(v.begin() + 1, 100);
+        assert(MoveCounter::num_move_constructed == 1 && MoveCounter::num_move_assigned == 3);
+        assert(v[1].id == 100 && v[2].id == 1 && v[5].id == 4);
+        //     -   
+        MoveCounter::ResetCounters();
+        v.Emplace(v.begin(), v[5].id);
+        assert(v[0].id == 4 && v[1].id == 0 && v.Size() == 7);
+    }
+    // -   :     ,
+    //    ,     
+    {
+        struct FromPointer {
+            FromPointer(int x) noexcept  // NOLINT(google-explicit-constructor)
+                : x(x) {
+            }
+            FromPointer(const FromPointer* other) noexcept  // NOLINT(google-explicit-constructor)
+                : x(other->x) {
+            }
+            int x;
+        };
+        struct TrackedFromPointer : FromPointer {
+            using FromPointer::FromPointer;
+            TrackedFromPointer(const TrackedFromPointer& other) noexcept = default;
+            TrackedFromPointer(TrackedFromPointer&& other) noexcept
+                : FromPointer(other.x) {
+            }
+            TrackedFromPointer& operator=(const TrackedFromPointer& other) noexcept = default;
+            TrackedFromPointer& operator=(TrackedFromPointer&& other) noexcept = default;
+        };
+        static_assert(is_trivially_relocatable_v<FromPointer> && !is_trivially_relocatable_v<TrackedFromPointer>);
+        const auto check = [](auto& v) {
+            v.Reserve(8);
+            v.EmplaceBack(1);
+            v.EmplaceBack(2);
+            v.EmplaceBack(3);
+            v.Emplace(v.begin(), &v[1]);
+            assert(v.Size() == 4 && v[0].x == 2 && v[1].x == 1 && v[2].x == 2 && v[3].x == 3);
+        };
+        Vector<FromPointer> relocatable;
+        check(relocatable);
+        Vector<TrackedFromPointer> tracked;
+        check(tracked);
+    }
+    {
+        Vector<std::string> v{ "a", "c" };
+        v.Reserve(4);
+        v.Emplace(v.begin() + 1, v[1]);
+        v.Emplace(v.begin(), 3, 'x');
+        const std::string expected[] = { "xxx", "a", "c", "c" };
+        assert(v.Size() == 4 && std::equal(v.begin(), v.end(), std::begin(expected)));
+    }
+    //    
+    {
+        Vector<int> v;
+        std::vector<int> expected;
+        for (int round = 0; round < 5; ++round) {
+            std::vector<int> keys;
+            for (int i = 0; i < 300; ++i) {
+                keys.push_back((i * 7919 + round * 104729) % 1000);
+            }
+            std::sort(keys.begin(), keys.end());
+            v.InsertSorted(keys.begin(), keys.end());
+            expected.insert(expected.end(), keys.begin(), keys.end());
+            std::sort(expected.begin(), expected.end());
+            assert(v.Size() == expected.size() && std::equal(v.begin(), v.end(), expected.begin()));
+        }
+        v.InsertSorted(expected.begin(), expected.begin());
+        assert(v.Size() == 1500);
+    }
+    {
+        //     ,      
+        using Entry = std::pair<int, std::string>;
+        const auto by_key = [](const Entry& lhs, const Entry& rhs) {
+            return lhs.first > rhs.first;
+        };
+        Vector<Entry> v{ { 5, "old" }, { 3, "old" }, { 1, "old" } };
+        const Entry keys[] = { { 6, "new" }, { 3, "new" }, { 3, "new2" }, { 0, "new" } };
+        v.InsertSorted(std::begin(keys), std::end(keys), by_key);
+        const Entry expected[] = { { 6, "new" }, { 5, "old" }, { 3, "old" }, { 3, "new" },
+                                   { 3, "new2" }, { 1, "old" }, { 0, "new" } };
+        assert(v.Size() == 7 && std::equal(v.begin(), v.end(), std::begin(expected)));
+    }
+}
+
+void Test30() {
+    //      std::lower_bound   
+    for (size_t size = 0; size < 70; ++size) {
+        Vector<int> v(size);
+        for (size_t i = 0; i < size; ++i) {
+            v[i] = static_cast<int>(i / 2 * 2);
+        }
+        for (int key = -1; key <= static_cast<int>(size) + 1; ++key) {
+            const size_t expected = std::lower_bound(v.begin(), v.end(), key) - v.begin();
+            assert(flat::LowerBound(v.Data(), size, key, std::less<>()) == expected);
+        }
+    }
+    {
+        const int keys[] = { 5, 1, 3, 5, 1, 9 };
+        FlatSet<int> set(std::begin(keys), std::end(keys));
+        assert(set.Size() == 4 && std::is_sorted(set.begin(), set.end()));
+        assert(set.Contains(3) && !set.Contains(4));
+        assert(set.Insert(4) && !set.Insert(4));
+        assert(set.Erase(1) && !set.Erase(1));
+        const int more[] = { 9, 0, 7, 0 };
+        set.InsertBulk(std::begin(more), std::end(more));
+        const int expected[] = { 0, 3, 4, 5, 7, 9 };
+        assert(set.Size() == 6 && std::equal(set.begin(), set.end(), std::begin(expected)));
+        //     Flush;    
+        set.InsertBuffered(100);
+        assert(!set.Contains(100) && set.PendingSize() == 1);
+        set.Flush();
+        assert(set.Contains(100) && set.PendingSize() == 0);
+        for (int i = 0; i < 1000; ++i) {
+            set.InsertBuffered(i % 500);
+        }
+        assert(set.PendingSize() < 1000);
+        set.Flush();
+        assert(set.Size() == 500 && std::is_sorted(set.begin(), set.end()));
+        //     ,         
+        set.InsertBuffered(1000);
+        assert(!set.Contains(1000) && set.Size() == 500);
+        assert(set.Erase(1000) && set.PendingSize() == 0);
+        set.Flush();
+        assert(!set.Contains(1000) && set.Size() == 500);
+    }
+    {
+        FlatSet<std::string, std::greater<>> names{ "b", "a", "c", "a" };
+        const std::string expected[] = { "c", "b", "a" };
+        assert(names.Size() == 3 && std::equal(names.begin(), names.end(), std::begin(expected)));
+    }
+    // FlatMap  std::map   
+    {
+        FlatMap<int, std::string> map{ { 2, "two" }, { 1, "one" }, { 2, "second two" } };
+        assert(map.Size() == 2 && map.At(2) == "two" && map.KeyAt(0) == 1);
+        assert(map.Insert(3, "three") && !map.Insert(3, "drei"));
+        assert(!map.InsertOrAssign(3, std::string("drei")) && *map.Find(3) == "drei");
+        map[4] += "four";
+        assert(map.At(4) == "four" && map.Find(5) == nullptr);
+        try {
+            map.At(5);
+            assert(false);
+        }
+        catch (const std::out_of_range&) {
+        }
+        const std::pair<int, std::string> bulk[] = { { 0, "zero" }, { 1, "uno" } };
+        map.InsertBulk(std::begin(bulk), std::end(bulk));
+        assert(map.Size() == 5 && map.At(0) == "zero" && map.At(1) == "one");
+        map.InsertBuffered(1, "uno");
+        map.InsertBuffered(9, "nine");
+        map.InsertBuffered(1, "eins");
+        assert(map.At(1) == "one");
+        map.Flush();
+        assert(map.Size() == 6 && map.At(1) == "eins" && map.At(9) == "nine");
+        assert(map.Erase(9) && !map.Erase(9));
+        assert(map.Keys().Size() == map.Values().Size());
+        //     ,       
+        map.InsertBuffered(7, "seven");
+        assert(!map.Contains(7) && map.Find(7) == nullptr && map.Size() == 5);
+        assert(map.Erase(7) && map.PendingSize() == 0);
+        map.Flush();
+        assert(!map.Contains(7));
+        map.InsertBuffered(8, "eight");
+        assert(!map.InsertOrAssign(8, std::string("acht")));
+        map.Flush();
+        assert(map.At(8) == "acht");
+    }
+    {
+        FlatMap<int, int> flat;
+        std::map<int, int> reference;
+        unsigned state = 1;
+        for (int i = 0; i < 20000; ++i) {
+            state = state * 1103515245 + 12345;
+            const int key = static_cast<int>(state >> 16) % 2000;
+            switch (i % 4) {
+                case 0:
+                    flat.InsertOrAssign(key, i);
+                    reference[key] = i;
+                    break;
+                case 1:
+                    flat.Erase(key);
+                    reference.erase(key);
+                    break;
+                case 2:
+                    flat.InsertBuffered(key, i);
+                    flat.Flush();
+                    reference[key] = i;
+                    break;
+                default:
+                    assert(flat.Contains(key) == (reference.count(key) != 0));
+            }
+        }
+        assert(flat.Size() == reference.size());
+        size_t index = 0;
+        for (const auto& [key, value] : reference) {
+            assert(flat.KeyAt(index) == key && flat.ValueAt(index) == value);
+            ++index;
+        }
+    }
+}
+
+#if VECTOR_HAS_CONSTEXPR
+namespace {
+
+    //  N  ,     Vector
+    template <size_t N>
+    constexpr std::array<int, N> MakePrimes() {
+        Vector<int> primes;
+        for (int candidate = 2; primes.Size() < N; ++candidate) {
+            bool is_prime = true;
+            for (const int prime : primes) {
+                is_prime = is_prime && candidate % prime != 0;
+            }
+            if (is_prime) {
+                primes.PushBack(candidate);
+            }
+        }
+        std::array<int, N> table{};
+        for (size_t i = 0; i < N; ++i) {
+            table[i] = primes[i];
+        }
+        return table;
+    }
+
+    //   , , Reserve  PopBack   
+    constexpr size_t ConstexprStringsLength() {
+        Vector<std::string> words{ "alpha", "beta" };
+        words.Reserve(3);
+        for (int i = 0; i < 10; ++i) {
+            words.EmplaceBack(static_cast<size_t>(i), 'x');
+        }
+        Vector<std::string> copy = words;
+        copy.PopBack();
+        Vector<std::string> moved = std::move(copy);
+        size_t length = 0;
+        for (const std::string& word : moved) {
+            length += word.size();
+        }
+        return length + words.Size() * 100 + Vector<int>(7).Size() * 1000;
+    }
+
+}  // namespace
+#endif
+
+void Test31() {
+#if VECTOR_HAS_CONSTEXPR
+    static constexpr std::array<int, 100> PRIMES = MakePrimes<100>();
+    static_assert(PRIMES[0] == 2 && PRIMES[99] == 541);
+    static_assert(ConstexprStringsLength() == 9 + 36 + 1200 + 7000);
+    //        
+    assert(MakePrimes<100>() == PRIMES);
+    volatile size_t length = ConstexprStringsLength();
+    assert(length == 8245);
+#endif
+}
+
+void Test32() {
+    //   :    ,  
+    {
+        using Ints = InplaceVector<int, 8>;
+        static_assert(std::is_trivially_copyable_v<Ints>);
+        static_assert(sizeof(Ints) == 8 * sizeof(int) + sizeof(size_t));
+        static_assert(!std::is_trivially_copyable_v<InplaceVector<std::string, 2>>);
+
+        Ints v{ 1, 2, 3 };
+        v.EmplaceBack(5);
+        assert(v.Emplace(v.begin() + 3, 4) == v.begin() + 3);
+        //    ,    
+        v.Insert(v.begin(), v[4]);
+        assert(std::equal(v.begin(), v.end(), std::array{ 5, 1, 2, 3, 4, 5 }.begin()));
+        assert(v.Erase(v.begin()) == v.begin());
+        v.Erase(v.begin() + 1, v.begin() + 3);
+        assert(std::equal(v.begin(), v.end(), std::array{ 1, 4, 5 }.begin()));
+
+        //   ,    
+        alignas(Ints) unsigned char shared[sizeof(Ints)];
+        std::memcpy(shared, &v, sizeof(Ints));
+        Ints copy;
+        std::memcpy(&copy, shared, sizeof(Ints));
+        assert(copy.Size() == 3 && copy[2] == 5);
+
+        v.Resize(8);
+        assert(v.Full() && v[7] == 0);
+        assert(v.TryEmplaceBack(1) == nullptr);
+        bool thrown = false;
+        try {
+            v.PushBack(1);
+        }
+        catch (const std::bad_alloc&) {
+            thrown = true;
+        }
+        assert(thrown && v.Size() == 8);
+        thrown = false;
+        try {
+            v.Insert(v.begin(), 1);
+        }
+        catch (const std::bad_alloc&) {
+            thrown = true;
+        }
+        assert(thrown && v[0] == 1 && v[7] == 0);
+        v.Resize(2);
+        assert(v.Size() == 2 && *v.TryEmplaceBack(9) == 9);
+    }
+    //  
+    {
+        using Strings = InplaceVector<std::string, 4>;
+        Strings v;
+        assert(v.Empty() && Strings::Capacity() == 4);
+        v.EmplaceBack(3, 'a');
+        v.Emplace(v.begin(), "first");
+        v.Insert(v.begin() + 1, v[1]);
+        assert(v.Size() == 3 && v[0] == "first" && v[1] == "aaa" && v[2] == "aaa");
+        v.Erase(v.begin());
+        Strings copy = v;
+        Strings moved = std::move(copy);
+        assert(moved.Size() == 2 && moved[1] == "aaa");
+        Strings other{ "x", "y", "z" };
+        other.Swap(moved);
+        assert(other.Size() == 2 && moved.Size() == 3 && moved[2] == "z" && other[0] == "aaa");
+        other = moved;
+        assert(other.Size() == 3 && other[0] == "x");
+        moved.Resize(1);
+        other = std::move(moved);
+        assert(other.Size() == 1 && other[0] == "x");
+        other.PopBack();
+        assert(other.Empty());
+    }
+    //   :       
+    {
+        InplaceVector<std::unique_ptr<int>, 16> v;
+        int* first = v.EmplaceBack(std::make_unique<int>(1)).get();
+        std::unique_ptr<int>* slot = &v[0];
+        for (int i = 0; i < 15; ++i) {
+            assert(v.TryEmplaceBack(std::make_unique<int>(i)) != nullptr);
+        }
+        assert(&v[0] == slot && v[0].get() == first);
+        v.Erase(v.begin());
+        assert(v.Size() == 15 && *v[0] == 0);
+    }
+}
+
+#if VECTOR_HARDENED
+namespace {
+
+    volatile int64_t HARDENING_SINK = 0;
+
+    //  action     ,    
+    template <typename Action>
+    bool Crashes(Action action) {
+        const pid_t pid = fork();
+        if (pid == 0) {
+            //    ASan     
+            std::freopen("/dev/null", "w", stderr);
+            action();
+            _exit(0);
+        }
+        int status = 0;
+        waitpid(pid, &status, 0);
+        return !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+    }
+
+}  // namespace
+#endif
+
+void Test33() {
+    // At     
+    {
+        Vector<int> v{ 1, 2, 3 };
+        const Vector<int>& cv = v;
+        assert(v.At(2) == 3 && cv.At(0) == 1);
+        bool thrown = false;
+        try {
+            v.At(3);
+        }
+        catch (const std::out_of_range&) {
+            thrown = true;
+        }
+        assert(thrown);
+        assert(v.Data() == v.View().Data() && cv.Data() + cv.Size() == cv.View().end());
+    }
+#if VECTOR_HARDENED
+    //  ,    
+    {
+        Vector<int> v;
+        v.Reserve(4);
+        v.EmplaceBack(1);
+        Vector<int>::iterator it = v.begin();
+        v.EmplaceBack(2);
+        Vector<int>::const_iterator cit = it;
+        assert(*it == 1 && cit == v.cbegin() && v.end() - it == 2 && it[1] == 2);
+
+        assert(Crashes([&] {
+            v.Reserve(100);
+            HARDENING_SINK = *it;
+        }));
+        assert(Crashes([&] {
+            for (int i = 0; i < 10; ++i) {
+                v.EmplaceBack(i);
+            }
+            HARDENING_SINK = it == v.begin();
+        }));
+        assert(Crashes([&] {
+            v.Insert(it, 0);
+            v.ShrinkToFit();
+            v.Insert(it, 0);
+        }));
+        assert(Crashes([&] {
+            Vector<int> other = std::move(v);
+            HARDENING_SINK = *it;
+        }));
+        //       
+        assert(Crashes([&] {
+            v.PopBack();
+            HARDENING_SINK = it[1];
+        }));
+        assert(Crashes([&] {
+            HARDENING_SINK = v[2];
+        }));
+        //    
+        assert(Crashes([&] {
+            Vector<int> other{ 1 };
+            HARDENING_SINK = other.begin() == v.begin();
+        }));
+        assert(!Crashes([&] {
+            HARDENING_SINK = *it + v[1];
+        }));
+        assert(v.Size() == 2 && *it == 1);
+    }
+#endif
+#if VECTOR_ANNOTATE_CONTAINER
+    //     ASan
+    {
+        Vector<int64_t> v;
+        v.Reserve(16);
+        v.PushBack(1);
+        v.PushBack(2);
+        const int64_t* data = v.Data();
+        assert(__sanitizer_verify_contiguous_container(data, data + 2, data + 16));
+        assert(Crashes([&] {
+            HARDENING_SINK = v.Data()[5];
+        }));
+        v.Resize(10);
+        assert(__sanitizer_verify_contiguous_container(data, data + 10, data + 16));
+        v.Erase(v.begin(), v.begin() + 7);
+        assert(__sanitizer_verify_contiguous_container(data, data + 3, data + 16));
+        HARDENING_SINK = v.Data()[2];
+        v.Clear();
+        assert(__sanitizer_verify_contiguous_container(data, data, data + 16));
+    }
+#endif
+}
+
+void Test34() {
+    using CountedVector = Vector<int, std::allocator<int>, DoublingGrowth, InstanceStats>;
+    const size_t STEPS = 1000;
+    //  Reserve      , ReserveAtLeast -   
+    {
+        CountedVector exact;
+        CountedVector amortized;
+        for (size_t i = 0; i < STEPS; ++i) {
+            exact.Reserve(exact.Size() + 3);
+            amortized.ReserveAtLeast(amortized.Size() + 3);
+            for (int j = 0; j < 3; ++j) {
+                exact.PushBack(j);
+                amortized.PushBack(j);
+            }
+        }
+        assert(exact.GetStats().Get().allocations == STEPS);
+        assert(amortized.GetStats().Get().allocations <= 10);
+        assert(amortized.Size() == 3 * STEPS && amortized.Capacity() >= amortized.Size());
+
+        CountedVector v;
+        v.ReserveExact(37);
+        assert(v.Capacity() == 37);
+        v.ReserveAtLeast(20);
+        assert(v.Capacity() == 37);
+        v.ReserveAtLeast(38);
+        assert(v.Capacity() == 74);
+    }
+    // Resize   ,  
+    {
+        CountedVector v;
+        for (size_t i = 0; i < STEPS; ++i) {
+            v.Resize(v.Size() + 1);
+        }
+        assert(v.Size() == STEPS && v.GetStats().Get().allocations <= 10);
+        assert(v.Capacity() == 1024);
+        v.ResizeDefaultInit(v.Capacity() + 1);
+        assert(v.Capacity() == 2 * 1024);
+    }
+    //  :      ,     
+    {
+        using RowsVector = Vector<int, std::allocator<int>, DoublingGrowth, HintedStats<RowsTag>>;
+        const size_t ROWS = 300;
+        const auto fill = [](RowsVector& v, size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                v.EmplaceBack(static_cast<int>(i));
+            }
+        };
+        assert(RowsVector().GetStats().CapacityHint() == 0);
+        {
+            RowsVector first;
+            fill(first, ROWS);
+            assert(first.Capacity() == 512);
+            //       
+            RowsVector moved = std::move(first);
+        }
+        VectorStats stats = HintedStats<RowsTag>::Get();
+        assert(stats.final_sizes == 1 && stats.typical_final_size == ROWS);
+        const size_t allocations = stats.allocations;
+        {
+            RowsVector v;
+            fill(v, ROWS);
+            assert(v.Capacity() == ROWS);
+        }
+        assert(HintedStats<RowsTag>::Get().allocations == allocations + 1);
+
+        //     ,  -   
+        for (int i = 0; i < 20; ++i) {
+            RowsVector v;
+            fill(v, 2 * ROWS);
+        }
+        const size_t hint = HintedStats<RowsTag>::CapacityHint();
+        assert(hint > ROWS && hint <= 2 * ROWS);
+        //    Reserve   
+        RowsVector sized(5);
+        assert(sized.Capacity() == 5);
+        RowsVector reserved;
+        reserved.Reserve(10);
+        assert(reserved.Capacity() == 10);
+        std::ostringstream out;
+        StatsRegistry::Export(out);
+        assert(out.str().find("rows ") != std::string::npos && out.str().find(" final_sizes=22 ") != std::string::npos);
     }
 }
 
@@ -654,7 +2904,34 @@ int main() {
         Test4();
         Test5();
         Test6();
-        Benchmark();
+        Test7();
+        Test8();
+        Test9();
+        Test10();
+        Test11();
+        Test12();
+        Test13();
+        Test14();
+        Test15();
+        Test16();
+        Test17();
+        Test18();
+        Test19();
+        Test20();
+        Test21();
+        Test22();
+        Test23();
+        Test24();
+        Test25();
+        Test26();
+        Test27();
+        Test28();
+        Test29();
+        Test30();
+        Test31();
+        Test32();
+        Test33();
+        Test34();
     }
     catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
@@ -0,0 +1,333 @@
+#pragma once
+#include "vector.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+enum class MappedMode {
+    READ_WRITE,  //  ,   
+    READ_ONLY,
+};
+
+//    T,         .
+//      :  ,  , 
+//    .      ,    ,
+//      T .    ftruncate  mremap, , 
+//    Vector,      .
+//      Flush     ; T    ,
+//             T.
+//   READ_ONLY     :      ,
+//         SIGSEGV,    
+//   const.   : Size()  Capacity()  0, Data() - nullptr
+template <typename T>
+class MappedVector {
+    static_assert(std::is_trivially_copyable_v<T>, "MappedVector stores T bytewise");
+
+    struct Header {
+        uint64_t magic;
+        uint64_t type_hash;
+        uint64_t elem_size;
+        uint64_t size;
+        uint64_t capacity;
+    };
+
+    //    -,       alignof(T)
+    static constexpr size_t HEADER_SIZE = 64;
+    static_assert(sizeof(Header) <= HEADER_SIZE && HEADER_SIZE % alignof(T) == 0);
+
+    static constexpr uint64_t MAGIC = 0x3156454450414d56;  // "VMAPDEV1"
+
+public:
+    //  FNV-1a  ,    .    typeid,  
+    //   ,   
+    static uint64_t TypeHash() noexcept {
+        uint64_t hash = 0xcbf29ce484222325;
+        const auto mix = [&hash](unsigned char byte) {
+            hash = (hash ^ byte) * 0x100000001b3;
+        };
+        for (const char* name = typeid(T).name(); *name != '\0'; ++name) {
+            mix(static_cast<unsigned char>(*name));
+        }
+        for (size_t value : { sizeof(T), alignof(T) }) {
+            for (size_t i = 0; i < sizeof(value); ++i) {
+                mix(static_cast<unsigned char>(value >> (i * 8)));
+            }
+        }
+        return hash;
+    }
+
+    //   path.   -  std::system_error,  
+    //   MappedVector<T> - std::runtime_error
+    explicit MappedVector(const std::string& path, MappedMode mode = MappedMode::READ_WRITE)
+        : MappedVector(OpenFile(path, mode), mode == MappedMode::READ_ONLY)
+    {
+        struct stat status {};
+        if (fstat(fd_, &status) != 0) {
+            throw SystemError("fstat");
+        }
+        const size_t file_size = static_cast<size_t>(status.st_size);
+        if (file_size == 0 && !read_only_) {
+            Truncate(HEADER_SIZE);
+            Map(HEADER_SIZE);
+            *GetHeader() = Header{ MAGIC, TypeHash(), sizeof(T), 0, 0 };
+            return;
+        }
+        if (file_size < HEADER_SIZE) {
+            throw std::runtime_error("MappedVector: " + path + " is too short");
+        }
+        Map(file_size);
+        const Header& header = *GetHeader();
+        if (header.magic != MAGIC || header.elem_size != sizeof(T) || header.type_hash != TypeHash()) {
+            throw std::runtime_error("MappedVector: " + path + " holds a different type");
+        }
+        if (header.size > header.capacity || header.capacity > (file_size - HEADER_SIZE) / sizeof(T)) {
+            throw std::runtime_error("MappedVector: " + path + " is truncated");
+        }
+    }
+
+    MappedVector(const MappedVector&) = delete;
+    MappedVector& operator=(const MappedVector&) = delete;
+
+    MappedVector(MappedVector&& other) noexcept
+        : fd_(std::exchange(other.fd_, -1))
+        , read_only_(other.read_only_)
+        , base_(std::exchange(other.base_, nullptr))
+        , mapped_bytes_(std::exchange(other.mapped_bytes_, 0)) {
+    }
+
+    MappedVector& operator=(MappedVector&& rhs) noexcept {
+        if (this != &rhs) {
+            Swap(rhs);
+        }
+        return *this;
+    }
+
+    //  .             Flush,
+    //          Flush
+    ~MappedVector() {
+        if (base_ != nullptr) {
+            munmap(base_, mapped_bytes_);
+        }
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+    }
+
+    void Swap(MappedVector& other) noexcept {
+        std::swap(fd_, other.fd_);
+        std::swap(read_only_, other.read_only_);
+        std::swap(base_, other.base_);
+        std::swap(mapped_bytes_, other.mapped_bytes_);
+    }
+
+    bool IsReadOnly() const noexcept {
+        return read_only_;
+    }
+
+    size_t Size() const noexcept {
+        return base_ != nullptr ? GetHeader()->size : 0;
+    }
+
+    size_t Capacity() const noexcept {
+        return base_ != nullptr ? GetHeader()->capacity : 0;
+    }
+
+    T* Data() noexcept {
+        return base_ != nullptr ? reinterpret_cast<T*>(base_ + HEADER_SIZE) : nullptr;
+    }
+
+    const T* Data() const noexcept {
+        return base_ != nullptr ? reinterpret_cast<const T*>(base_ + HEADER_SIZE) : nullptr;
+    }
+
+    T* begin() noexcept {
+        return Data();
+    }
+    T* end() noexcept {
+        return Data() + Size();
+    }
+    const T* begin() const noexcept {
+        return Data();
+    }
+    const T* end() const noexcept {
+        return Data() + Size();
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < Size());
+        return Data()[index];
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        assert(index < Size());
+        return Data()[index];
+    }
+
+    Span<T> View() noexcept {
+        return { Data(), Size() };
+    }
+
+    Span<const T> View() const noexcept {
+        return { Data(), Size() };
+    }
+
+    //      new_capacity 
+    void Reserve(size_t new_capacity) {
+        assert(!read_only_);
+        if (new_capacity <= Capacity()) {
+            return;
+        }
+        if (new_capacity > (std::numeric_limits<size_t>::max() - HEADER_SIZE) / sizeof(T)) {
+            throw std::length_error("MappedVector: capacity is too large");
+        }
+        const size_t new_bytes = HEADER_SIZE + new_capacity * sizeof(T);
+        Truncate(new_bytes);
+        Remap(new_bytes);
+        GetHeader()->capacity = new_capacity;
+    }
+
+    //       ,     
+    // ,      
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        assert(!read_only_);
+        //     ,     
+        const T value(std::forward<Args>(args)...);
+        const size_t size = Size();
+        if (size == Capacity()) {
+            Reserve(DoublingGrowth::NextCapacity(Capacity(), size + 1, sizeof(T)));
+        }
+        T* elem = new (Data() + size) T(value);
+        GetHeader()->size = size + 1;
+        return *elem;
+    }
+
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    //   items  . items      
+    void Append(Span<const T> items) {
+        assert(!read_only_);
+        const size_t size = Size();
+        if (size + items.Size() > Capacity()) {
+            Reserve(DoublingGrowth::NextCapacity(Capacity(), size + items.Size(), sizeof(T)));
+        }
+        if (!items.Empty()) {
+            std::memcpy(static_cast<void*>(Data() + size), static_cast<const void*>(items.Data()),
+                        items.Size() * sizeof(T));
+        }
+        GetHeader()->size = size + items.Size();
+    }
+
+    void PopBack() noexcept {
+        assert(!read_only_ && Size() != 0);
+        --GetHeader()->size;
+    }
+
+    //     T{}.     
+    void Resize(size_t new_size) {
+        assert(!read_only_);
+        const size_t size = Size();
+        if (new_size > size) {
+            if (new_size > Capacity()) {
+                Reserve(DoublingGrowth::NextCapacity(Capacity(), new_size, sizeof(T)));
+            }
+            std::uninitialized_value_construct_n(Data() + size, new_size - size);
+        }
+        GetHeader()->size = new_size;
+    }
+
+    void Clear() noexcept {
+        assert(!read_only_);
+        GetHeader()->size = 0;
+    }
+
+    //      
+    void Flush() {
+        assert(!read_only_);
+        if (msync(base_, mapped_bytes_, MS_SYNC) != 0) {
+            throw SystemError("msync");
+        }
+    }
+
+private:
+    MappedVector(int fd, bool read_only) noexcept
+        : fd_(fd)
+        , read_only_(read_only) {
+    }
+
+    static std::system_error SystemError(const std::string& what) {
+        return std::system_error(errno, std::generic_category(), "MappedVector: " + what);
+    }
+
+    static int OpenFile(const std::string& path, MappedMode mode) {
+        const int flags = mode == MappedMode::READ_ONLY ? O_RDONLY : O_RDWR | O_CREAT;
+        const int fd = open(path.c_str(), flags | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            throw SystemError("open " + path);
+        }
+        return fd;
+    }
+
+    Header* GetHeader() noexcept {
+        return reinterpret_cast<Header*>(base_);
+    }
+
+    const Header* GetHeader() const noexcept {
+        return reinterpret_cast<const Header*>(base_);
+    }
+
+    void Truncate(size_t bytes) {
+        if (ftruncate(fd_, static_cast<off_t>(bytes)) != 0) {
+            throw SystemError("ftruncate");
+        }
+    }
+
+    void Map(size_t bytes) {
+        const int protection = read_only_ ? PROT_READ : PROT_READ | PROT_WRITE;
+        void* p = mmap(nullptr, bytes, protection, MAP_SHARED, fd_, 0);
+        if (p == MAP_FAILED) {
+            throw SystemError("mmap");
+        }
+        base_ = static_cast<unsigned char*>(p);
+        mapped_bytes_ = bytes;
+    }
+
+    //     bytes.     
+    void Remap(size_t bytes) {
+#if defined(__linux__)
+        void* p = mremap(base_, mapped_bytes_, bytes, MREMAP_MAYMOVE);
+        if (p == MAP_FAILED) {
+            throw SystemError("mremap");
+        }
+        base_ = static_cast<unsigned char*>(p);
+        mapped_bytes_ = bytes;
+#else
+        unsigned char* old_base = base_;
+        const size_t old_bytes = mapped_bytes_;
+        Map(bytes);
+        munmap(old_base, old_bytes);
+#endif
+    }
+
+    int fd_ = -1;
+    bool read_only_ = false;
+    unsigned char* base_ = nullptr;
+    size_t mapped_bytes_ = 0;
+};
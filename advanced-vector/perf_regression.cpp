@@ -0,0 +1,653 @@
+//    Vector   :
+//   g++ -std=c++17 -O2 -pthread perf_regression.cpp -o perf_regression
+//   ./perf_regression record perf_baseline.txt   -  
+//   ./perf_regression check perf_baseline.txt    -   ,   1  
+//   ./perf_regression stress                     -   ConcurrentVector  RecyclingAllocator
+//        , ,  ,
+//        .    
+// :    Emplace       -    .
+//         --time-tolerance (,   1.0 - 
+//  ); --no-timing   
+#include "vector.h"
+#include "allocators.h"
+#include "concurrent_vector.h"
+#include "vector_stats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    using Clock = std::chrono::steady_clock;
+
+    // ,    .  noexcept,   ,
+    //           
+    struct Counted {
+        static inline size_t copies = 0;
+        static inline size_t moves = 0;
+
+        static void ResetCounters() noexcept {
+            copies = 0;
+            moves = 0;
+        }
+
+        Counted(int value = 0) noexcept  // NOLINT(google-explicit-constructor)
+            : value(value) {
+        }
+        Counted(const Counted& other) noexcept
+            : value(other.value) {
+            ++copies;
+        }
+        Counted(Counted&& other) noexcept
+            : value(other.value) {
+            ++moves;
+        }
+        Counted& operator=(const Counted& rhs) noexcept {
+            value = rhs.value;
+            ++copies;
+            return *this;
+        }
+        Counted& operator=(Counted&& rhs) noexcept {
+            value = rhs.value;
+            ++moves;
+            return *this;
+        }
+
+        bool operator<(const Counted& rhs) const noexcept {
+            return value < rhs.value;
+        }
+
+        int value;
+    };
+
+    //          
+    struct Measurement {
+        size_t allocations = 0;
+        size_t reallocations = 0;
+        size_t relocated = 0;
+        size_t copies = 0;
+        size_t moves = 0;
+        double ns_per_op = 0.0;
+    };
+
+    //    :     
+    class Probe {
+    public:
+        //  ; before -  ,    
+        void Begin(const VectorStats& before = {}) noexcept {
+            before_ = before;
+            Counted::ResetCounters();
+            start_ = Clock::now();
+        }
+
+        //  ; after -     
+        void End(const VectorStats& after) noexcept {
+            elapsed_ += Clock::now() - start_;
+            last_.allocations = after.allocations - before_.allocations;
+            last_.reallocations = after.reallocations - before_.reallocations;
+            last_.relocated = (after.relocated_bytewise + after.relocated_moved + after.relocated_copied)
+                - (before_.relocated_bytewise + before_.relocated_moved + before_.relocated_copied);
+            last_.copies = Counted::copies;
+            last_.moves = Counted::moves;
+        }
+
+        const Measurement& Last() const noexcept {
+            return last_;
+        }
+
+        Clock::duration Elapsed() const noexcept {
+            return elapsed_;
+        }
+
+    private:
+        VectorStats before_;
+        Measurement last_;
+        Clock::time_point start_;
+        Clock::duration elapsed_{};
+    };
+
+    //   ops   Begin  End
+    struct Scenario {
+        std::string name;
+        size_t ops;
+        std::function<void(Probe&)> run;
+    };
+
+    constexpr auto MIN_MEASURE_TIME = std::chrono::milliseconds(20);
+    constexpr size_t MIN_RUNS = 3;
+    constexpr size_t MAX_RUNS = 1 << 16;
+
+    //     ,  -   
+    Measurement Measure(const Scenario& scenario) {
+        Probe probe;
+        scenario.run(probe);
+        Measurement result = probe.Last();
+        size_t runs = 1;
+        while (runs < MAX_RUNS && (runs < MIN_RUNS || probe.Elapsed() < MIN_MEASURE_TIME)) {
+            scenario.run(probe);
+            ++runs;
+        }
+        const double ns = std::chrono::duration<double, std::nano>(probe.Elapsed()).count();
+        result.ns_per_op = ns / static_cast<double>(runs * scenario.ops);
+        return result;
+    }
+
+    template <typename T>
+    using StatsVector = Vector<T, std::allocator<T>, DoublingGrowth, InstanceStats>;
+
+    template <typename T>
+    StatsVector<T> MakeFilled(size_t size, size_t extra_capacity = 0) {
+        StatsVector<T> v;
+        v.Reserve(size + extra_capacity);
+        for (size_t i = 0; i < size; ++i) {
+            v.EmplaceBack(static_cast<int>(i));
+        }
+        return v;
+    }
+
+    constexpr size_t BATCH = 64;  //        
+
+    template <typename T>
+    void AddScenarios(std::vector<Scenario>& scenarios, std::string_view type_name, size_t n) {
+        const auto name = [type_name, n](std::string_view operation) {
+            std::ostringstream out;
+            out << operation << '/' << type_name << '/' << n;
+            return out.str();
+        };
+
+        scenarios.push_back({ name("PushBack"), n, [n](Probe& probe) {
+            StatsVector<T> v;
+            const T value(1);
+            probe.Begin(v.GetStats().Get());
+            for (size_t i = 0; i < n; ++i) {
+                v.PushBack(value);
+            }
+            probe.End(v.GetStats().Get());
+        } });
+
+        scenarios.push_back({ name("EmplaceBack"), n, [n](Probe& probe) {
+            StatsVector<T> v;
+            probe.Begin(v.GetStats().Get());
+            for (size_t i = 0; i < n; ++i) {
+                v.EmplaceBack(static_cast<int>(i));
+            }
+            probe.End(v.GetStats().Get());
+        } });
+
+        scenarios.push_back({ name("ReserveAtLeast"), n, [n](Probe& probe) {
+            StatsVector<T> v;
+            probe.Begin(v.GetStats().Get());
+            for (size_t i = 0; i < n; ++i) {
+                v.ReserveAtLeast(v.Size() + 1);
+                v.EmplaceBack(static_cast<int>(i));
+            }
+            probe.End(v.GetStats().Get());
+        } });
+
+        scenarios.push_back({ name("Resize"), n, [n](Probe& probe) {
+            StatsVector<T> v;
+            probe.Begin(v.GetStats().Get());
+            for (size_t i = 1; i <= n; ++i) {
+                v.Resize(i);
+            }
+            probe.End(v.GetStats().Get());
+        } });
+
+        //       :  
+        scenarios.push_back({ name("EmplaceMiddle"), BATCH, [n](Probe& probe) {
+            StatsVector<T> v = MakeFilled<T>(n, BATCH);
+            probe.Begin(v.GetStats().Get());
+            for (size_t i = 0; i < BATCH; ++i) {
+                v.Emplace(v.begin() + v.Size() / 2, static_cast<int>(i));
+            }
+            probe.End(v.GetStats().Get());
+        } });
+
+        //     :     
+        scenarios.push_back({ name("EmplaceFull"), 1, [n](Probe& probe) {
+            StatsVector<T> v = MakeFilled<T>(n);
+            probe.Begin(v.GetStats().Get());
+            v.Emplace(v.begin() + v.Size() / 2, 1);
+            probe.End(v.GetStats().Get());
+        } });
+
+        scenarios.push_back({ name("InsertRange"), 1, [n](Probe& probe) {
+            StatsVector<T> v = MakeFilled<T>(n);
+            const std::vector<T> range(BATCH, T(1));
+            probe.Begin(v.GetStats().Get());
+            v.Insert(v.begin() + v.Size() / 2, range.begin(), range.end());
+            probe.End(v.GetStats().Get());
+        } });
+
+        scenarios.push_back({ name("EraseMiddle"), BATCH, [n](Probe& probe) {
+            StatsVector<T> v = MakeFilled<T>(n + BATCH);
+            probe.Begin(v.GetStats().Get());
+            for (size_t i = 0; i < BATCH; ++i) {
+                v.Erase(v.begin() + v.Size() / 2);
+            }
+            probe.End(v.GetStats().Get());
+        } });
+
+        scenarios.push_back({ name("Copy"), 1, [n](Probe& probe) {
+            const StatsVector<T> v = MakeFilled<T>(n);
+            probe.Begin();
+            StatsVector<T> copy(v);
+            probe.End(copy.GetStats().Get());
+        } });
+
+        scenarios.push_back({ name("AssignGrow"), 1, [n](Probe& probe) {
+            const StatsVector<T> src = MakeFilled<T>(n);
+            StatsVector<T> v = MakeFilled<T>(n / 2);
+            probe.Begin(v.GetStats().Get());
+            v = src;
+            probe.End(v.GetStats().Get());
+        } });
+
+        //  n / 4       n 
+        scenarios.push_back({ name("InsertSorted"), 1, [n](Probe& probe) {
+            StatsVector<T> v;
+            v.Reserve(n);
+            for (size_t i = 0; i < n; ++i) {
+                v.EmplaceBack(static_cast<int>(2 * i));
+            }
+            std::vector<T> values;
+            for (size_t i = 0; i < n / 4; ++i) {
+                values.emplace_back(static_cast<int>(8 * i + 1));
+            }
+            probe.Begin(v.GetStats().Get());
+            v.InsertSorted(values.begin(), values.end());
+            probe.End(v.GetStats().Get());
+        } });
+
+        scenarios.push_back({ name("ShrinkToFit"), 1, [n](Probe& probe) {
+            StatsVector<T> v = MakeFilled<T>(n, n);
+            probe.Begin(v.GetStats().Get());
+            v.ShrinkToFit();
+            probe.End(v.GetStats().Get());
+        } });
+    }
+
+    std::vector<Scenario> MakeScenarios() {
+        std::vector<Scenario> scenarios;
+        for (size_t n : { size_t{ 16 }, size_t{ 1024 }, size_t{ 65536 } }) {
+            AddScenarios<int>(scenarios, "int", n);
+            AddScenarios<Counted>(scenarios, "Counted", n);
+        }
+        return scenarios;
+    }
+
+    //  : "<> allocations=... ns_per_op=..."
+    void WriteMeasurement(std::ostream& out, const std::string& name, const Measurement& m) {
+        out << name << " allocations=" << m.allocations << " reallocations=" << m.reallocations
+            << " relocated=" << m.relocated << " copies=" << m.copies << " moves=" << m.moves
+            << " ns_per_op=" << std::fixed << std::setprecision(3) << m.ns_per_op << '\n';
+    }
+
+    using Metrics = std::map<std::string, double, std::less<>>;
+    using Baseline = std::map<std::string, Metrics, std::less<>>;
+
+    Baseline ReadBaseline(std::istream& in) {
+        Baseline baseline;
+        std::string line;
+        while (std::getline(in, line)) {
+            std::istringstream fields(line);
+            std::string name;
+            if (!(fields >> name) || name[0] == '#') {
+                continue;
+            }
+            Metrics& metrics = baseline[name];
+            std::string field;
+            while (fields >> field) {
+                const size_t eq = field.find('=');
+                if (eq == std::string::npos) {
+                    throw std::runtime_error("malformed baseline field: " + field);
+                }
+                metrics[field.substr(0, eq)] = std::stod(field.substr(eq + 1));
+            }
+        }
+        return baseline;
+    }
+
+    struct CheckOptions {
+        bool timing = true;
+        double time_tolerance = 1.0;
+    };
+
+    //          
+    constexpr double MIN_TIME_REGRESSION_NS = 2.0;
+
+    //       .  false  
+    bool Compare(const std::string& name, const Measurement& m, const Metrics& base, const CheckOptions& options) {
+        bool ok = true;
+        const auto counter = [&](std::string_view metric, size_t value) {
+            const auto it = base.find(metric);
+            if (it == base.end()) {
+                return;
+            }
+            const auto expected = static_cast<size_t>(it->second);
+            if (value > expected) {
+                std::cout << "REGRESSION " << name << ' ' << metric << ": " << expected << " -> " << value << '\n';
+                ok = false;
+            }
+            else if (value < expected) {
+                std::cout << "improved   " << name << ' ' << metric << ": " << expected << " -> " << value
+                          << " (update the baseline)\n";
+            }
+        };
+        counter("allocations", m.allocations);
+        counter("reallocations", m.reallocations);
+        counter("relocated", m.relocated);
+        counter("copies", m.copies);
+        counter("moves", m.moves);
+        const auto it = base.find("ns_per_op");
+        if (options.timing && it != base.end()) {
+            const double delta = m.ns_per_op - it->second;
+            if (delta > options.time_tolerance * it->second && delta > MIN_TIME_REGRESSION_NS) {
+                std::cout << "REGRESSION " << name << " ns_per_op: " << it->second << " -> " << m.ns_per_op << '\n';
+                ok = false;
+            }
+        }
+        return ok;
+    }
+
+    int Record(const std::string& path) {
+        std::ofstream out(path);
+        if (!out) {
+            std::cerr << "cannot write " << path << '\n';
+            return 2;
+        }
+        out << "# Vector perf baseline, see perf_regression.cpp\n";
+        for (const Scenario& scenario : MakeScenarios()) {
+            WriteMeasurement(out, scenario.name, Measure(scenario));
+        }
+        return 0;
+    }
+
+    int Check(const std::string& path, const CheckOptions& options) {
+        std::ifstream in(path);
+        if (!in) {
+            std::cerr << "cannot read " << path << '\n';
+            return 2;
+        }
+        const Baseline baseline = ReadBaseline(in);
+        size_t regressions = 0;
+        size_t checked = 0;
+        for (const Scenario& scenario : MakeScenarios()) {
+            const Measurement m = Measure(scenario);
+            const auto it = baseline.find(scenario.name);
+            if (it == baseline.end()) {
+                std::cout << "new        " << scenario.name << " (not in the baseline)\n";
+                continue;
+            }
+            ++checked;
+            if (!Compare(scenario.name, m, it->second, options)) {
+                ++regressions;
+            }
+        }
+        std::cout << checked << " operations checked, " << regressions << " regressed\n";
+        return regressions == 0 ? 0 : 1;
+    }
+
+    //  .         1
+
+    struct StressOptions {
+        size_t threads = std::max(2u, std::thread::hardware_concurrency());
+        double seconds = 2.0;
+    };
+
+    bool StressFailure(const std::string& what) {
+        std::cout << "STRESS FAILURE: " << what << '\n';
+        return false;
+    }
+
+    //     ConcurrentVector  (, ),  
+    //       .   Freeze  
+    //     
+    bool StressConcurrentVector(const StressOptions& options, size_t& rounds_done) {
+        constexpr uint64_t PER_THREAD = 20000;
+        const auto deadline = Clock::now() + std::chrono::duration<double>(options.seconds / 2);
+        ConcurrentVector<uint64_t> values;
+        do {
+            std::atomic<bool> writers_done{ false };
+            std::atomic<bool> reader_ok{ true };
+            std::thread reader([&] {
+                while (!writers_done.load(std::memory_order_acquire)) {
+                    const size_t size = values.Size();
+                    for (size_t i = 0; i < size; ++i) {
+                        const uint64_t* value = values.TryGet(i);
+                        if (value != nullptr && ((*value >> 32) >= options.threads || (*value & 0xFFFFFFFF) >= PER_THREAD)) {
+                            reader_ok.store(false, std::memory_order_relaxed);
+                        }
+                    }
+                }
+            });
+            std::vector<std::thread> writers;
+            for (uint64_t t = 0; t < options.threads; ++t) {
+                writers.emplace_back([&values, t] {
+                    for (uint64_t i = 0; i < PER_THREAD; ++i) {
+                        values.EmplaceBack(t << 32 | i);
+                    }
+                });
+            }
+            for (std::thread& writer : writers) {
+                writer.join();
+            }
+            writers_done.store(true, std::memory_order_release);
+            reader.join();
+            if (!reader_ok.load()) {
+                return StressFailure("ConcurrentVector published a corrupted element");
+            }
+            if (values.Size() != options.threads * PER_THREAD) {
+                return StressFailure("ConcurrentVector lost reserved slots");
+            }
+            Vector<uint64_t> frozen = values.Freeze();
+            std::sort(frozen.begin(), frozen.end());
+            for (uint64_t t = 0; t < options.threads; ++t) {
+                for (uint64_t i = 0; i < PER_THREAD; ++i) {
+                    if (frozen[t * PER_THREAD + i] != (t << 32 | i)) {
+                        return StressFailure("ConcurrentVector lost or duplicated an element");
+                    }
+                }
+            }
+            if (values.Size() != 0) {
+                return StressFailure("ConcurrentVector is not empty after Freeze");
+            }
+            ++rounds_done;
+        } while (Clock::now() < deadline);
+        return true;
+    }
+
+    struct StressTag {
+        static constexpr std::string_view NAME = "stress";
+    };
+
+    using RecycledVector = Vector<uint64_t, RecyclingAllocator<uint64_t>, DoublingGrowth, TaggedStats<StressTag>>;
+
+    //       RecyclingAllocator,    
+    // ,     ,  .     
+    // ,     TaggedStats     
+    bool StressRecycler(const StressOptions& options, size_t& vectors_done) {
+        const auto deadline = Clock::now() + std::chrono::duration<double>(options.seconds / 2);
+        const VectorStats before = TaggedStats<StressTag>::Get();
+        struct Mailbox {
+            std::mutex mutex;
+            std::deque<RecycledVector> vectors;
+        };
+        std::vector<Mailbox> mailboxes(options.threads);
+        std::atomic<bool> ok{ true };
+        std::atomic<size_t> created{ 0 };
+        std::atomic<size_t> hits{ 0 };
+
+        const auto check = [](const RecycledVector& v) {
+            for (size_t i = 0; i < v.Size(); ++i) {
+                if (v[i] != (v.Size() ^ i)) {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < options.threads; ++t) {
+            workers.emplace_back([&, t] {
+                uint64_t seed = 0x9E3779B97F4A7C15ull * (t + 1);
+                const auto next = [&seed] {
+                    seed ^= seed << 13;
+                    seed ^= seed >> 7;
+                    seed ^= seed << 17;
+                    return seed;
+                };
+                size_t local_created = 0;
+                const size_t hits_before = BufferRecycler::Local().Hits();
+                while (Clock::now() < deadline) {
+                    for (int iteration = 0; iteration < 256; ++iteration) {
+                        const size_t size = 1 + next() % 2000;
+                        RecycledVector v;
+                        v.Reserve(size);
+                        for (size_t i = 0; i < size; ++i) {
+                            v.PushBack(size ^ i);
+                        }
+                        ++local_created;
+                        if (!check(v)) {
+                            ok.store(false, std::memory_order_relaxed);
+                        }
+                        if (next() % 4 == 0) {
+                            Mailbox& mailbox = mailboxes[(t + 1) % mailboxes.size()];
+                            std::lock_guard guard(mailbox.mutex);
+                            mailbox.vectors.push_back(std::move(v));
+                        }
+                    }
+                    //          
+                    std::deque<RecycledVector> received;
+                    {
+                        std::lock_guard guard(mailboxes[t].mutex);
+                        received.swap(mailboxes[t].vectors);
+                    }
+                    for (const RecycledVector& v : received) {
+                        if (!check(v)) {
+                            ok.store(false, std::memory_order_relaxed);
+                        }
+                    }
+                }
+                created.fetch_add(local_created, std::memory_order_relaxed);
+                hits.fetch_add(BufferRecycler::Local().Hits() - hits_before, std::memory_order_relaxed);
+            });
+        }
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+        mailboxes.clear();
+
+        if (!ok.load()) {
+            return StressFailure("RecyclingAllocator handed out a buffer that was still in use");
+        }
+        const VectorStats after = TaggedStats<StressTag>::Get();
+        if (after.allocations - before.allocations != created.load() || after.reallocations != before.reallocations) {
+            return StressFailure("shared stats counters lost updates");
+        }
+        if (after.final_sizes - before.final_sizes != created.load()) {
+            return StressFailure("OnFinalSize was not reported for every vector");
+        }
+        if (hits.load() == 0) {
+            return StressFailure("BufferRecycler never reused a buffer");
+        }
+        vectors_done = created.load();
+        return true;
+    }
+
+    int Stress(const StressOptions& options) {
+        size_t rounds = 0;
+        size_t vectors = 0;
+        if (!StressConcurrentVector(options, rounds) || !StressRecycler(options, vectors)) {
+            return 1;
+        }
+        std::cout << "stress passed: " << options.threads << " threads, " << rounds << " ConcurrentVector rounds, "
+                  << vectors << " recycled vectors\n";
+        return 0;
+    }
+
+    int Usage() {
+        std::cerr << "usage: perf_regression [print]\n"
+                     "       perf_regression record <baseline>\n"
+                     "       perf_regression check <baseline> [--time-tolerance=<fraction>] [--no-timing]\n"
+                     "       perf_regression stress [--threads=<n>] [--seconds=<s>]\n";
+        return 2;
+    }
+
+    //    --name=value  nullptr,  arg -  
+    const char* OptionValue(std::string_view arg, std::string_view name) {
+        if (arg.size() > name.size() + 1 && arg.substr(0, name.size()) == name && arg[name.size()] == '=') {
+            return arg.data() + name.size() + 1;
+        }
+        return nullptr;
+    }
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    const std::string_view mode = argc > 1 ? argv[1] : "print";
+    try {
+        if (mode == "print") {
+            for (const Scenario& scenario : MakeScenarios()) {
+                WriteMeasurement(std::cout, scenario.name, Measure(scenario));
+            }
+            return 0;
+        }
+        if (mode == "record" && argc == 3) {
+            return Record(argv[2]);
+        }
+        if (mode == "check" && argc >= 3) {
+            CheckOptions options;
+            for (int i = 3; i < argc; ++i) {
+                const std::string_view arg = argv[i];
+                if (const char* value = OptionValue(arg, "--time-tolerance")) {
+                    options.time_tolerance = std::stod(value);
+                }
+                else if (arg == "--no-timing") {
+                    options.timing = false;
+                }
+                else {
+                    return Usage();
+                }
+            }
+            return Check(argv[2], options);
+        }
+        if (mode == "stress") {
+            StressOptions options;
+            for (int i = 2; i < argc; ++i) {
+                const std::string_view arg = argv[i];
+                if (const char* value = OptionValue(arg, "--threads")) {
+                    options.threads = std::max<size_t>(1, std::stoul(value));
+                }
+                else if (const char* value = OptionValue(arg, "--seconds")) {
+                    options.seconds = std::stod(value);
+                }
+                else {
+                    return Usage();
+                }
+            }
+            return Stress(options);
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "error: " << e.what() << '\n';
+        return 2;
+    }
+    return Usage();
+}
@@ -0,0 +1,192 @@
+#pragma once
+#include "vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+//   SegmentedVector  
+inline constexpr size_t DEFAULT_SEGMENT_BYTES = 4096;
+
+//    ,   DEFAULT_SEGMENT_BYTES (   1)
+template <typename T>
+constexpr size_t DefaultSegmentSize() noexcept {
+    size_t size = 1;
+    while (size * 2 * sizeof(T) <= DEFAULT_SEGMENT_BYTES) {
+        size *= 2;
+    }
+    return size;
+}
+
+//     BLOCK_SIZE ,    .  
+//        ,     :
+//         ,  T  
+// .     ,     
+template <typename T, size_t BLOCK_SIZE = DefaultSegmentSize<T>(), typename Alloc = std::allocator<T>>
+class SegmentedVector {
+    static_assert(BLOCK_SIZE > 0 && (BLOCK_SIZE & (BLOCK_SIZE - 1)) == 0, "BLOCK_SIZE must be a power of two");
+
+    using Block = RawMemory<T, Alloc>;
+
+public:
+    static constexpr size_t SEGMENT_SIZE = BLOCK_SIZE;
+
+    SegmentedVector() = default;
+
+    explicit SegmentedVector(const Alloc& alloc)
+        : alloc_(alloc) {
+    }
+
+    //     ,     
+    SegmentedVector(const SegmentedVector& other)
+        : SegmentedVector(std::allocator_traits<Alloc>::select_on_container_copy_construction(other.alloc_)) {
+        blocks_.Reserve(other.blocks_.Size());
+        for (size_t i = 0; i < other.size_; ++i) {
+            EmplaceBack(other[i]);
+        }
+    }
+
+    SegmentedVector(SegmentedVector&& other) noexcept
+        : blocks_(std::move(other.blocks_))
+        , size_(std::exchange(other.size_, 0))
+        , alloc_(other.alloc_) {
+    }
+
+    SegmentedVector& operator=(const SegmentedVector& rhs) {
+        if (this != &rhs) {
+            SegmentedVector copy(rhs);
+            Swap(copy);
+        }
+        return *this;
+    }
+
+    SegmentedVector& operator=(SegmentedVector&& rhs) noexcept {
+        if (this != &rhs) {
+            Swap(rhs);
+        }
+        return *this;
+    }
+
+    ~SegmentedVector() {
+        Clear();
+    }
+
+    void Swap(SegmentedVector& other) noexcept {
+        blocks_.Swap(other.blocks_);
+        std::swap(size_, other.size_);
+        std::swap(alloc_, other.alloc_);
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return blocks_.Size() * BLOCK_SIZE;
+    }
+
+    size_t BlockCount() const noexcept {
+        return blocks_.Size();
+    }
+
+    T& operator[](size_t index) noexcept {
+        assert(index < size_);
+        return blocks_[index / BLOCK_SIZE][index % BLOCK_SIZE];
+    }
+
+    const T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return blocks_[index / BLOCK_SIZE][index % BLOCK_SIZE];
+    }
+
+    //    O(1),   .     
+    template <typename... Args>
+    T& EmplaceBack(Args&&... args) {
+        if (size_ < Capacity()) {
+            T* elem = new (blocks_[size_ / BLOCK_SIZE] + size_ % BLOCK_SIZE) T(std::forward<Args>(args)...);
+            ++size_;
+            return *elem;
+        }
+        //     ,       
+        if (blocks_.Size() == blocks_.Capacity()) {
+            blocks_.Reserve(blocks_.Size() == 0 ? 1 : blocks_.Size() * 2);
+        }
+        Block block(BLOCK_SIZE, alloc_);
+        T* elem = new (block.GetAddress()) T(std::forward<Args>(args)...);
+        blocks_.EmplaceBack(std::move(block));
+        ++size_;
+        return *elem;
+    }
+
+    void PushBack(const T& value) {
+        EmplaceBack(value);
+    }
+
+    void PushBack(T&& value) {
+        EmplaceBack(std::move(value));
+    }
+
+    //      , . ShrinkToFit
+    void PopBack() noexcept {
+        assert(size_ != 0);
+        --size_;
+        std::destroy_at(blocks_[size_ / BLOCK_SIZE] + size_ % BLOCK_SIZE);
+    }
+
+    //   ,  
+    void Clear() noexcept {
+        for (size_t block = 0; block * BLOCK_SIZE < size_; ++block) {
+            std::destroy_n(blocks_[block].GetAddress(), std::min(BLOCK_SIZE, size_ - block * BLOCK_SIZE));
+        }
+        size_ = 0;
+    }
+
+    //  ,     
+    void ShrinkToFit() noexcept {
+        const size_t used_blocks = (size_ + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        while (blocks_.Size() > used_blocks) {
+            blocks_.PopBack();
+        }
+    }
+
+    //     Vector        .
+    //     ,         
+    //          . ,
+    //     , ,      
+    // .   ,       
+    Vector<T, Alloc> ToVector() && {
+        constexpr bool MOVE = std::is_nothrow_move_constructible_v<T>;
+        static_assert(MOVE || std::is_copy_constructible_v<T>, "ToVector needs a nothrow-movable or copyable T");
+        Vector<T, Alloc> result(alloc_);
+        result.Reserve(size_);
+        for (size_t block = 0; block * BLOCK_SIZE < size_; ++block) {
+            T* first = blocks_[block].GetAddress();
+            const size_t count = std::min(BLOCK_SIZE, size_ - block * BLOCK_SIZE);
+            if constexpr (MOVE) {
+                result.Insert(result.end(), std::make_move_iterator(first), std::make_move_iterator(first + count));
+                std::destroy_n(first, count);
+                Block(alloc_).Swap(blocks_[block]);
+            }
+            else {
+                result.Insert(result.end(), first, first + count);
+            }
+        }
+        if constexpr (MOVE) {
+            size_ = 0;
+        }
+        else {
+            Clear();
+        }
+        blocks_ = Vector<Block>();
+        return result;
+    }
+
+private:
+    Vector<Block> blocks_;
+    size_t size_ = 0;
+    Alloc alloc_;
+};
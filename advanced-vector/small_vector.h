@@ -0,0 +1,217 @@
+#pragma once
+#include "vector.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+//      N ,  InlineBufferAllocator   
+template <typename T, size_t N>
+struct InlineBuffer {
+    T* Data() noexcept {
+        return reinterpret_cast<T*>(storage);
+    }
+
+    const T* Data() const noexcept {
+        return reinterpret_cast<const T*>(storage);
+    }
+
+    alignas(T) unsigned char storage[N * sizeof(T)];
+    bool in_use = false;
+};
+
+// ,    ,     N    ,
+//     .  ,         ,
+//       ,     
+template <typename T, size_t N>
+class InlineBufferAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+    using is_always_equal = std::false_type;
+
+    //      T,     
+    template <typename U>
+    struct rebind {
+        using other = std::conditional_t<std::is_same_v<U, T>, InlineBufferAllocator, std::allocator<U>>;
+    };
+
+    //        
+    InlineBufferAllocator() noexcept = default;
+
+    explicit InlineBufferAllocator(InlineBuffer<T, N>& buffer) noexcept
+        : buffer_(&buffer) {
+    }
+
+    T* allocate(size_t n) {
+        if (buffer_ != nullptr && !buffer_->in_use && n <= N) {
+            buffer_->in_use = true;
+            return buffer_->Data();
+        }
+        return std::allocator<T>().allocate(n);
+    }
+
+    // GCC   ,      ,  
+    //       ,   
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wfree-nonheap-object"
+#endif
+    void deallocate(T* p, size_t n) noexcept {
+        if (buffer_ != nullptr && p == buffer_->Data()) {
+            buffer_->in_use = false;
+            return;
+        }
+        std::allocator<T>().deallocate(p, n);
+    }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+    //        
+    InlineBufferAllocator select_on_container_copy_construction() const noexcept {
+        return InlineBufferAllocator();
+    }
+
+    bool operator==(const InlineBufferAllocator& other) const noexcept {
+        return buffer_ == other.buffer_;
+    }
+
+    bool operator!=(const InlineBufferAllocator& other) const noexcept {
+        return !(*this == other);
+    }
+
+private:
+    InlineBuffer<T, N>* buffer_ = nullptr;
+};
+
+//   SmallVector:    Growth,    N .  
+//    ,    ,       
+template <typename Growth, size_t N>
+struct InlineBufferShrinkingGrowth : Growth {
+    static size_t ShrinkCapacity(size_t capacity, size_t size, size_t elem_size) noexcept {
+        if (capacity <= N) {
+            return capacity;
+        }
+        const size_t new_capacity = Growth::ShrinkCapacity(capacity, size, elem_size);
+        return new_capacity < capacity && size <= N ? N : std::max(new_capacity, N);
+    }
+};
+
+//      ,  SmallVector  Vector    
+template <typename Growth, size_t N>
+using InlineBufferGrowth = std::conditional_t<has_shrink_capacity_v<Growth>, InlineBufferShrinkingGrowth<Growth, N>, Growth>;
+
+// ,   N           .
+//   Vector         .
+//        ;    
+//   ,       
+template <typename T, size_t N, typename Growth = DoublingGrowth>
+class SmallVector : private InlineBuffer<T, N>, public Vector<T, InlineBufferAllocator<T, N>, InlineBufferGrowth<Growth, N>> {
+    static_assert(N > 0, "SmallVector needs a non-empty inline buffer");
+
+    using Buffer = InlineBuffer<T, N>;
+    using Base = Vector<T, InlineBufferAllocator<T, N>, InlineBufferGrowth<Growth, N>>;
+
+    static constexpr bool NOTHROW_MOVE = std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_assignable_v<T>;
+
+public:
+    using typename Base::iterator;
+    using typename Base::const_iterator;
+    // Data()     ;    
+    using Base::Data;
+
+    static constexpr size_t INLINE_CAPACITY = N;
+
+    SmallVector()
+        : Base(InlineBufferAllocator<T, N>(static_cast<Buffer&>(*this))) {
+        Base::Reserve(N);
+    }
+
+    explicit SmallVector(size_t size)
+        : SmallVector() {
+        Base::Resize(size);
+    }
+
+    SmallVector(const SmallVector& other)
+        : SmallVector() {
+        Base::operator=(other);
+    }
+
+    SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : SmallVector() {
+        MoveFrom(other);
+    }
+
+    //        ,   
+    //  .      ,      
+    SmallVector& operator=(const SmallVector& rhs) {
+        try {
+            Base::operator=(rhs);
+        }
+        catch (...) {
+            if (Base::Size() == 0) {
+                ShrinkToFit();
+            }
+            throw;
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& rhs) noexcept(NOTHROW_MOVE) {
+        if (this != &rhs) {
+            MoveFrom(rhs);
+        }
+        return *this;
+    }
+
+    void Swap(SmallVector& other) noexcept(NOTHROW_MOVE) {
+        SmallVector tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+    //     ,     
+    void ShrinkToFit() {
+        if (IsInline()) {
+            return;
+        }
+        if (Base::Size() <= N) {
+            Base::Reallocate(N);
+        }
+        else {
+            Base::ShrinkToFit();
+        }
+    }
+
+    //      
+    bool IsInline() const noexcept {
+        return Base::Data() == static_cast<const Buffer&>(*this).Data();
+    }
+
+private:
+    //    SmallVector    ,   
+    //   . Release      ,  Reset  Adopt 
+    //       ,    
+    using Base::Adopt;
+    using Base::Release;
+    using Base::Reset;
+
+    //      InlineBufferAllocator,     
+    //   ,  other    .   
+    // other           
+    void MoveFrom(SmallVector& other) noexcept(NOTHROW_MOVE) {
+        if (other.IsInline()) {
+            Base::operator=(std::move(other));
+            return;
+        }
+        const typename Base::Buffer buffer = other.Release();
+        Base::Adopt(buffer.data, buffer.size, buffer.capacity);
+        //   other      ,     
+        other.Base::Reserve(N);
+    }
+};
@@ -0,0 +1,302 @@
+#pragma once
+#include "vector.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+//  ,       RawMemory (" ").
+// ,      ,          .
+//        .       .
+//     Vector::Reserve:       ,
+//    ,      
+template <typename... Fields>
+class SoaVector {
+    static_assert(sizeof...(Fields) > 0, "SoaVector needs at least one field");
+
+    using Columns = std::tuple<RawMemory<Fields>...>;
+
+    template <size_t I>
+    using Field = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+    // ,   ,      
+    template <typename T>
+    static constexpr bool NEEDS_COPY = !is_trivially_relocatable_v<T> && !std::is_nothrow_move_constructible_v<T>
+        && std::is_copy_constructible_v<T>;
+
+    //  ,       
+    static constexpr size_t RECORD_SIZE = (sizeof(Fields) + ...);
+
+public:
+    static constexpr size_t NUM_FIELDS = sizeof...(Fields);
+
+    using Reference = std::tuple<Fields&...>;
+    using ConstReference = std::tuple<const Fields&...>;
+
+    SoaVector() = default;
+
+    explicit SoaVector(size_t size)
+        : columns_(RawMemory<Fields>(size)...)
+        , size_(size)
+    {
+        ConstructColumns(columns_, 0, size, [](auto* to, size_t n, auto /*index*/) {
+            std::uninitialized_value_construct_n(to, n);
+        });
+    }
+
+    SoaVector(const SoaVector& other)
+        : columns_(RawMemory<Fields>(other.size_)...)
+        , size_(other.size_)
+    {
+        ConstructColumns(columns_, 0, size_, [&other](auto* to, size_t n, auto index) {
+            std::uninitialized_copy_n(std::get<decltype(index)::value>(other.columns_).GetAddress(), n, to);
+        });
+    }
+
+    SoaVector(SoaVector&& other) noexcept
+        : columns_(std::move(other.columns_))
+        , size_(std::exchange(other.size_, 0))
+    {
+    }
+
+    SoaVector& operator=(const SoaVector& rhs) {
+        if (this != &rhs) {
+            SoaVector copy(rhs);
+            Swap(copy);
+        }
+        return *this;
+    }
+
+    SoaVector& operator=(SoaVector&& rhs) noexcept {
+        if (this != &rhs) {
+            Swap(rhs);
+        }
+        return *this;
+    }
+
+    ~SoaVector() {
+        DestroyColumns(columns_, 0, size_);
+    }
+
+    void Swap(SoaVector& other) noexcept {
+        SwapColumns(columns_, other.columns_, Indices());
+        std::swap(size_, other.size_);
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    size_t Capacity() const noexcept {
+        return std::get<0>(columns_).Capacity();
+    }
+
+    Reference operator[](size_t index) noexcept {
+        assert(index < size_);
+        return RecordAt(index, Indices());
+    }
+
+    ConstReference operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return RecordAt(index, Indices());
+    }
+
+    //   I:   ,   SIMD-
+    template <size_t I>
+    Span<Field<I>> Column() noexcept {
+        return { std::get<I>(columns_).GetAddress(), size_ };
+    }
+
+    template <size_t I>
+    Span<const Field<I>> Column() const noexcept {
+        return { std::get<I>(columns_).GetAddress(), size_ };
+    }
+
+    void Reserve(size_t new_capacity) {
+        if (new_capacity <= Capacity()) {
+            return;
+        }
+        Columns new_columns = AllocateColumns(new_capacity, Indices());
+        RelocateColumns(columns_, new_columns, size_);
+        SwapColumns(columns_, new_columns, Indices());
+    }
+
+    //  , i-     i- .   
+    //    :        
+    template <typename... Args>
+    Reference EmplaceBack(Args&&... args) {
+        static_assert(sizeof...(Args) == sizeof...(Fields), "EmplaceBack takes one argument per field");
+        auto values = std::forward_as_tuple(std::forward<Args>(args)...);
+        const auto construct = [&values](auto* to, size_t /*n*/, auto index) {
+            new (to) Field<decltype(index)::value>(std::get<decltype(index)::value>(std::move(values)));
+        };
+        if (size_ == Capacity()) {
+            Columns new_columns
+                = AllocateColumns(DoublingGrowth::NextCapacity(Capacity(), size_ + 1, RECORD_SIZE), Indices());
+            ConstructColumns(new_columns, size_, 1, construct);
+            try {
+                RelocateColumns(columns_, new_columns, size_);
+            }
+            catch (...) {
+                DestroyColumns(new_columns, size_, 1);
+                throw;
+            }
+            SwapColumns(columns_, new_columns, Indices());
+        }
+        else {
+            ConstructColumns(columns_, size_, 1, construct);
+        }
+        ++size_;
+        return (*this)[size_ - 1];
+    }
+
+    void PopBack() noexcept {
+        assert(size_ != 0);
+        --size_;
+        DestroyColumns(columns_, size_, 1);
+    }
+
+    //     [first, last),    
+    void Erase(size_t first, size_t last) {
+        assert(first <= last && last <= size_);
+        const size_t count = last - first;
+        if (count == 0) {
+            return;
+        }
+        EraseFromColumns(first, count, Indices());
+        size_ -= count;
+    }
+
+    void Erase(size_t index) {
+        Erase(index, index + 1);
+    }
+
+    void Clear() noexcept {
+        DestroyColumns(columns_, 0, size_);
+        size_ = 0;
+    }
+
+private:
+    using Indices = std::index_sequence_for<Fields...>;
+
+    template <size_t... I>
+    static Columns AllocateColumns(size_t capacity, std::index_sequence<I...>) {
+        return Columns(RawMemory<Field<I>>(capacity)...);
+    }
+
+    template <size_t... I>
+    static void SwapColumns(Columns& lhs, Columns& rhs, std::index_sequence<I...>) noexcept {
+        (std::get<I>(lhs).Swap(std::get<I>(rhs)), ...);
+    }
+
+    template <size_t... I>
+    Reference RecordAt(size_t index, std::index_sequence<I...>) noexcept {
+        return Reference(std::get<I>(columns_)[index]...);
+    }
+
+    template <size_t... I>
+    ConstReference RecordAt(size_t index, std::index_sequence<I...>) const noexcept {
+        return ConstReference(std::get<I>(columns_)[index]...);
+    }
+
+    //  construct(, count, std::integral_constant<size_t, I>)    I,
+    //    offset. construct      ,  
+    //    
+    template <size_t I = 0, typename Construct>
+    static void ConstructColumns(Columns& columns, size_t offset, size_t count, const Construct& construct) {
+        if constexpr (I < NUM_FIELDS) {
+            construct(std::get<I>(columns) + offset, count, std::integral_constant<size_t, I>());
+            try {
+                ConstructColumns<I + 1>(columns, offset, count, construct);
+            }
+            catch (...) {
+                std::destroy_n(std::get<I>(columns) + offset, count);
+                throw;
+            }
+        }
+    }
+
+    static void DestroyColumns(Columns& columns, size_t offset, size_t count) noexcept {
+        std::apply(
+            [offset, count](auto&... column) {
+                (std::destroy_n(column + offset, count), ...);
+            },
+            columns);
+    }
+
+    //   to ,    .    
+    template <size_t I = 0>
+    static void CopyColumns(Columns& from, Columns& to, size_t count) {
+        if constexpr (I < NUM_FIELDS) {
+            if constexpr (NEEDS_COPY<Field<I>>) {
+                std::uninitialized_copy_n(std::get<I>(from).GetAddress(), count, std::get<I>(to).GetAddress());
+            }
+            try {
+                CopyColumns<I + 1>(from, to, count);
+            }
+            catch (...) {
+                if constexpr (NEEDS_COPY<Field<I>>) {
+                    std::destroy_n(std::get<I>(to).GetAddress(), count);
+                }
+                throw;
+            }
+        }
+    }
+
+    //  count   from  to,  
+    static void RelocateColumns(Columns& from, Columns& to, size_t count) {
+        CopyColumns(from, to, count);
+        //  ,   :   ,   
+        MoveOrDestroyColumns(from, to, count, Indices());
+    }
+
+    template <size_t... I>
+    static void MoveOrDestroyColumns(Columns& from, Columns& to, size_t count, std::index_sequence<I...>) {
+        const auto relocate = [count](auto& source, auto& destination, auto index) {
+            if constexpr (NEEDS_COPY<Field<decltype(index)::value>>) {
+                std::destroy_n(source.GetAddress(), count);
+            }
+            else {
+                UninitializedRelocateN(source.GetAddress(), count, destination.GetAddress());
+            }
+        };
+        (relocate(std::get<I>(from), std::get<I>(to), std::integral_constant<size_t, I>()), ...);
+    }
+
+    //   ,     :   
+    //      .       
+    template <size_t... I>
+    void EraseFromColumns(size_t first, size_t count, std::index_sequence<I...>) {
+        (ShiftColumn(std::get<I>(columns_), first, count), ...);
+        (TrimColumn(std::get<I>(columns_), first, count), ...);
+    }
+
+    template <typename T>
+    void ShiftColumn(RawMemory<T>& column, size_t first, size_t count) {
+        if constexpr (!is_trivially_relocatable_v<T>) {
+            T* begin = column.GetAddress();
+            std::move(begin + first + count, begin + size_, begin + first);
+        }
+    }
+
+    template <typename T>
+    void TrimColumn(RawMemory<T>& column, size_t first, size_t count) noexcept {
+        T* begin = column.GetAddress();
+        if constexpr (is_trivially_relocatable_v<T>) {
+            std::destroy_n(begin + first, count);
+            std::memmove(static_cast<void*>(begin + first), static_cast<const void*>(begin + first + count),
+                         (size_ - first - count) * sizeof(T));
+        }
+        else {
+            std::destroy_n(begin + size_ - count, count);
+        }
+    }
+
+    Columns columns_;
+    size_t size_ = 0;
+};
@@ -1,330 +1,1685 @@
 #pragma once
+#include "vector_hardening.h"
+#include "vector_stats.h"
+
 #include <cassert>
 #include <cstdlib>
+#include <cstring>
 #include <new>
 #include <utility>
 #include <memory>
 #include <iterator>
 #include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <type_traits>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+//  C++20   Vector  RawMemory  std::allocator    :
+//     constexpr-     .  
+//  std::construct_at,     
+#if defined(__cpp_lib_constexpr_dynamic_alloc) && __cpp_lib_constexpr_dynamic_alloc >= 201907L
+#define VECTOR_HAS_CONSTEXPR 1
+#define VECTOR_CONSTEXPR constexpr
+#else
+#define VECTOR_HAS_CONSTEXPR 0
+#define VECTOR_CONSTEXPR
+#endif
+
+constexpr bool IsConstantEvaluated() noexcept {
+#if VECTOR_HAS_CONSTEXPR
+    return std::is_constant_evaluated();
+#else
+    return false;
+#endif
+}
+
+//  new,    
+template <typename T, typename... Args>
+VECTOR_CONSTEXPR T* ConstructAt(T* p, Args&&... args) {
+#if VECTOR_HAS_CONSTEXPR
+    return std::construct_at(p, std::forward<Args>(args)...);
+#else
+    return new (static_cast<void*>(p)) T(std::forward<Args>(args)...);
+#endif
+}
+
+// std::uninitialized_copy_n  std::uninitialized_value_construct_n,    .
+//   -  ,       
+template <typename InputIt, typename T>
+VECTOR_CONSTEXPR void UninitializedCopyN(InputIt first, size_t n, T* to) {
+    if (IsConstantEvaluated()) {
+        for (size_t i = 0; i < n; ++i, ++first) {
+            ConstructAt(to + i, *first);
+        }
+    }
+    else {
+        std::uninitialized_copy_n(first, n, to);
+    }
+}
+
+template <typename T>
+VECTOR_CONSTEXPR void UninitializedValueConstructN(T* to, size_t n) {
+    if (IsConstantEvaluated()) {
+        for (size_t i = 0; i < n; ++i) {
+            ConstructAt(to + i);
+        }
+    }
+    else {
+        std::uninitialized_value_construct_n(to, n);
+    }
+}
+
+//  ,          ,
+//        .    
+//   ;       .
+// std::string   :  libstdc++        
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {};
+
+template <typename T, typename Deleter>
+struct is_trivially_relocatable<std::unique_ptr<T, Deleter>> : is_trivially_relocatable<Deleter> {};
+
+template <typename T>
+struct is_trivially_relocatable<std::shared_ptr<T>> : std::true_type {};
+
+template <typename T>
+struct is_trivially_relocatable<std::weak_ptr<T>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+//  n   from    to   .
+//    ,    
+template <typename T>
+VECTOR_CONSTEXPR void UninitializedRelocateN(T* from, size_t n, T* to) {
+    if (IsConstantEvaluated()) {
+        for (size_t i = 0; i < n; ++i) {
+            ConstructAt(to + i, std::move(from[i]));
+            std::destroy_at(from + i);
+        }
+        return;
+    }
+    if constexpr (is_trivially_relocatable_v<T>) {
+        if (n != 0) {
+            std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(T));
+        }
+    }
+    else {
+        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+            std::uninitialized_move_n(from, n, to);
+        }
+        else {
+            std::uninitialized_copy_n(from, n, to);
+        }
+        std::destroy_n(from, n);
+    }
+}
+
+// ,  UninitializedRelocateN    T
+template <typename T>
+inline constexpr RelocationKind RELOCATION_KIND = is_trivially_relocatable_v<T> ? RelocationKind::BYTEWISE
+    : std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T> ? RelocationKind::MOVED
+    : RelocationKind::COPIED;
+
+//  ,  UninitializedRelocateN,    to  gap_size ,
+//    gap
+template <typename T>
+VECTOR_CONSTEXPR void UninitializedRelocateWithGap(T* from, size_t n, size_t gap, T* to, size_t gap_size = 1) {
+    assert(gap <= n);
+    if constexpr (is_trivially_relocatable_v<T>) {
+        UninitializedRelocateN(from, gap, to);
+        UninitializedRelocateN(from + gap, n - gap, to + gap + gap_size);
+    }
+    else if (IsConstantEvaluated()) {
+        UninitializedRelocateN(from, gap, to);
+        UninitializedRelocateN(from + gap, n - gap, to + gap + gap_size);
+    }
+    else if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+        std::uninitialized_move_n(from, gap, to);
+        std::uninitialized_move_n(from + gap, n - gap, to + gap + gap_size);
+        std::destroy_n(from, n);
+    }
+    else {
+        std::uninitialized_copy_n(from, gap, to);
+        try {
+            std::uninitialized_copy_n(from + gap, n - gap, to + gap + gap_size);
+        }
+        catch (...) {
+            std::destroy_n(to, gap);
+            throw;
+        }
+        std::destroy_n(from, n);
+    }
+}
+
+//        [first, first + size).   
+//   ,    T:      . 
+//    ,   -   ,   ,  
+//   ,  - ""
+template <typename T, typename... Args>
+bool ArgsMayAlias(const T* first, size_t size, const Args&... args) noexcept {
+    if constexpr (((std::is_arithmetic_v<Args> || std::is_enum_v<Args> || std::is_same_v<Args, T>) && ...)) {
+        const auto inside = [first, size](const void* arg) {
+            const auto* byte = static_cast<const unsigned char*>(arg);
+            const auto* begin = reinterpret_cast<const unsigned char*>(first);
+            return std::less_equal<const unsigned char*>()(begin, byte)
+                && std::less<const unsigned char*>()(byte, begin + size * sizeof(T));
+        };
+        return (inside(std::addressof(args)) || ...);
+    }
+    else {
+        return true;
+    }
+}
+
+//    .       
+// ,    NUMA        
+struct ParallelPolicy {
+    static constexpr size_t MIN_CHUNK_BYTES = 1 << 20;
+
+    size_t max_threads = 0;                    // 0 - std::thread::hardware_concurrency()
+    size_t min_chunk_bytes = MIN_CHUNK_BYTES;  //      
+};
+
+inline constexpr ParallelPolicy PARALLEL{};
+
+//  count     to,      
+// construct(first, n)      .   construct  
+//     ,    std::uninitialized_*.  - 
+//  ,    ,     
+template <typename T, typename Construct>
+void ParallelUninitializedConstruct(const ParallelPolicy& policy, T* to, size_t count, Construct construct) {
+    const size_t max_threads = policy.max_threads != 0 ? policy.max_threads
+                                                       : std::max(std::thread::hardware_concurrency(), 1u);
+    const size_t min_chunk_size = std::max<size_t>(policy.min_chunk_bytes / sizeof(T), 1);
+    const size_t chunk_size = std::max((count + max_threads - 1) / max_threads, min_chunk_size);
+    const size_t num_chunks = (count + chunk_size - 1) / chunk_size;
+    if (num_chunks <= 1) {
+        construct(to, count);
+        return;
+    }
+
+    std::vector<std::exception_ptr> errors(num_chunks);
+    std::vector<std::thread> threads;
+    threads.reserve(num_chunks - 1);
+    const auto run = [&](size_t chunk) noexcept {
+        const size_t first = chunk * chunk_size;
+        try {
+            construct(to + first, std::min(chunk_size, count - first));
+        }
+        catch (...) {
+            errors[chunk] = std::current_exception();
+        }
+    };
+    size_t started = 1;
+    try {
+        for (; started < num_chunks; ++started) {
+            threads.emplace_back(run, started);
+        }
+    }
+    catch (...) {
+        //   :      
+    }
+    run(0);
+    for (size_t chunk = started; chunk < num_chunks; ++chunk) {
+        run(chunk);
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    const auto failed = std::find_if(errors.begin(), errors.end(), [](const std::exception_ptr& error) {
+        return error != nullptr;
+    });
+    if (failed == errors.end()) {
+        return;
+    }
+    for (size_t chunk = 0; chunk < num_chunks; ++chunk) {
+        if (errors[chunk] == nullptr) {
+            const size_t first = chunk * chunk_size;
+            std::destroy_n(to + first, std::min(chunk_size, count - first));
+        }
+    }
+    std::rethrow_exception(*failed);
+}
 
+//     :   .
+// ,    ,   
 template <typename T>
-class RawMemory {
+class Span {
+public:
+    Span() noexcept = default;
+
+    Span(T* data, size_t size) noexcept
+        : data_(data)
+        , size_(size) {
+    }
+
+    // Span<T>    Span<const T>
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    Span(const Span<U>& other) noexcept
+        : data_(other.Data())
+        , size_(other.Size()) {
+    }
+
+    T* begin() const noexcept {
+        return data_;
+    }
+
+    T* end() const noexcept {
+        return data_ + size_;
+    }
+
+    T* Data() const noexcept {
+        return data_;
+    }
+
+    size_t Size() const noexcept {
+        return size_;
+    }
+
+    bool Empty() const noexcept {
+        return size_ == 0;
+    }
+
+    T& operator[](size_t index) const noexcept {
+        assert(index < size_);
+        return data_[index];
+    }
+
+    //   count ,   offset
+    Span Subspan(size_t offset, size_t count) const noexcept {
+        assert(offset <= size_ && count <= size_ - offset);
+        return { data_ + offset, count };
+    }
+
+private:
+    T* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+//   ,  RawMemory     :
+//   bool expand(T* p, size_t old_n, size_t new_n)  -    ,   ;
+//   T* reallocate(T* p, size_t old_n, size_t new_n) -  ,   
+//                                                     ( realloc).    p  
+template <typename Alloc, typename = void>
+struct has_expand : std::false_type {};
+
+template <typename Alloc>
+struct has_expand<Alloc, std::void_t<decltype(std::declval<Alloc&>().expand(
+    std::declval<typename Alloc::value_type*>(), size_t{}, size_t{}))>> : std::true_type {};
+
+template <typename Alloc>
+inline constexpr bool has_expand_v = has_expand<Alloc>::value;
+
+template <typename Alloc, typename = void>
+struct has_reallocate : std::false_type {};
+
+template <typename Alloc>
+struct has_reallocate<Alloc, std::void_t<decltype(std::declval<Alloc&>().reallocate(
+    std::declval<typename Alloc::value_type*>(), size_t{}, size_t{}))>> : std::true_type {};
+
+template <typename Alloc>
+inline constexpr bool has_reallocate_v = has_reallocate<Alloc>::value;
+
+template <typename T, typename Alloc = std::allocator<T>>
+class RawMemory : private Alloc {
+    using AllocTraits = std::allocator_traits<Alloc>;
+    static_assert(std::is_same_v<typename AllocTraits::value_type, T>, "Alloc::value_type must be T");
+    static_assert(std::is_same_v<typename AllocTraits::pointer, T*>, "Alloc::pointer must be T*");
+
 public:
+    using allocator_type = Alloc;
+
+    //       (. Grow)
+    static constexpr bool CAN_GROW = has_expand_v<Alloc> || has_reallocate_v<Alloc>;
+
     RawMemory() = default;
 
-    explicit RawMemory(size_t capacity)
-        : buffer_(Allocate(capacity))
+    VECTOR_CONSTEXPR explicit RawMemory(const Alloc& alloc) noexcept
+        : Alloc(alloc) {
+    }
+
+    VECTOR_CONSTEXPR explicit RawMemory(size_t capacity, const Alloc& alloc = Alloc())
+        : Alloc(alloc)
+        , buffer_(Allocate(capacity))
         , capacity_(capacity) {
     }
 
-    ~RawMemory() {
-        Deallocate(buffer_);
+    //      capacity,    alloc
+    VECTOR_CONSTEXPR RawMemory(T* buffer, size_t capacity, const Alloc& alloc) noexcept
+        : Alloc(alloc)
+        , buffer_(buffer)
+        , capacity_(capacity) {
+    }
+
+    VECTOR_CONSTEXPR ~RawMemory() {
+        Deallocate(buffer_, capacity_);
     }
     RawMemory(const RawMemory&) = delete;
     RawMemory& operator=(const RawMemory& rhs) = delete;
 
-    RawMemory(RawMemory&& other) noexcept {
-        buffer_ = std::move(other.buffer_);
-        capacity_ = std::move(other.capacity_);
-        other.buffer_ = nullptr;
-        other.capacity_ = 0;
+    //      :     ,   
+    VECTOR_CONSTEXPR RawMemory(RawMemory&& other) noexcept
+        : Alloc(std::move(other.GetAllocator()))
+        , buffer_(std::exchange(other.buffer_, nullptr))
+        , capacity_(std::exchange(other.capacity_, 0)) {
     }
-    RawMemory& operator=(RawMemory&& rhs) noexcept {
+    VECTOR_CONSTEXPR RawMemory& operator=(RawMemory&& rhs) noexcept {
         if (this != &rhs) {
-            Deallocate(buffer_);
+            Deallocate(buffer_, capacity_);
+            buffer_ = nullptr;
             capacity_ = 0;
             Swap(rhs);
-
         }
         return *this;
     }
-    T* operator+(size_t offset) noexcept {
+    VECTOR_CONSTEXPR T* operator+(size_t offset) noexcept {
         //     ,     
-        assert(offset <= capacity_);
+        VECTOR_CHECK(offset <= capacity_, "RawMemory offset out of range");
         return buffer_ + offset;
     }
 
-    const T* operator+(size_t offset) const noexcept {
+    VECTOR_CONSTEXPR const T* operator+(size_t offset) const noexcept {
         return const_cast<RawMemory&>(*this) + offset;
     }
 
-    const T& operator[](size_t index) const noexcept {
+    VECTOR_CONSTEXPR const T& operator[](size_t index) const noexcept {
         return const_cast<RawMemory&>(*this)[index];
     }
 
-    T& operator[](size_t index) noexcept {
-        assert(index < capacity_);
+    VECTOR_CONSTEXPR T& operator[](size_t index) noexcept {
+        VECTOR_CHECK(index < capacity_, "RawMemory index out of range");
         return buffer_[index];
     }
 
-    void Swap(RawMemory& other) noexcept {
-        std::swap(buffer_, other.buffer_);
-        std::swap(capacity_, other.capacity_);
+    VECTOR_CONSTEXPR void Swap(RawMemory& other) noexcept {
+        using std::swap;
+        swap(GetAllocator(), other.GetAllocator());
+        swap(buffer_, other.buffer_);
+        swap(capacity_, other.capacity_);
     }
 
-    const T* GetAddress() const noexcept {
+    VECTOR_CONSTEXPR const T* GetAddress() const noexcept {
         return buffer_;
     }
 
-    T* GetAddress() noexcept {
+    VECTOR_CONSTEXPR T* GetAddress() noexcept {
         return buffer_;
     }
 
-    size_t Capacity() const {
+    VECTOR_CONSTEXPR size_t Capacity() const {
         return capacity_;
     }
 
+    //   ,     GetAllocator()
+    VECTOR_CONSTEXPR T* Release() noexcept {
+        capacity_ = 0;
+        return std::exchange(buffer_, nullptr);
+    }
+
+    //    new_capacity,    :    
+    //  ,     reallocate.   ,  
+    //      T.  false,     
+    //     reallocate;     
+    bool Grow(size_t new_capacity) {
+        static_assert(is_trivially_relocatable_v<T>, "Grow moves elements bytewise");
+        assert(new_capacity >= capacity_);
+        if (buffer_ == nullptr) {
+            buffer_ = Allocate(new_capacity);
+            capacity_ = new_capacity;
+            return true;
+        }
+        if constexpr (has_expand_v<Alloc>) {
+            if (GetAllocator().expand(buffer_, capacity_, new_capacity)) {
+                capacity_ = new_capacity;
+                return true;
+            }
+        }
+        if constexpr (has_reallocate_v<Alloc>) {
+            buffer_ = GetAllocator().reallocate(buffer_, capacity_, new_capacity);
+            capacity_ = new_capacity;
+            return true;
+        }
+        return false;
+    }
+
+    VECTOR_CONSTEXPR Alloc& GetAllocator() noexcept {
+        return *this;
+    }
+
+    VECTOR_CONSTEXPR const Alloc& GetAllocator() const noexcept {
+        return *this;
+    }
+
 private:
     //     n      
-    static T* Allocate(size_t n) {
-        return n != 0 ? static_cast<T*>(operator new(n * sizeof(T))) : nullptr;
+    VECTOR_CONSTEXPR T* Allocate(size_t n) {
+        return n != 0 ? AllocTraits::allocate(GetAllocator(), n) : nullptr;
     }
 
     //   ,     buf   Allocate
-    static void Deallocate(T* buf) noexcept {
-        operator delete(buf);
+    VECTOR_CONSTEXPR void Deallocate(T* buf, size_t n) noexcept {
+        if (buf != nullptr) {
+            AllocTraits::deallocate(GetAllocator(), buf, n);
+        }
     }
 
     T* buffer_ = nullptr;
     size_t capacity_ = 0;
 };
 
-template <typename T>
-class Vector {
+//      ,      required :
+//   static size_t NextCapacity(size_t capacity, size_t required, size_t elem_size)
+//    required.      MIN_INITIAL_BYTES ,
+//           
+inline constexpr size_t MIN_INITIAL_BYTES = 64;
+
+inline constexpr size_t MinInitialCapacity(size_t elem_size) noexcept {
+    return elem_size < MIN_INITIAL_BYTES ? MIN_INITIAL_BYTES / elem_size : 1;
+}
+
+//   2 :     50%  
+struct DoublingGrowth {
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t elem_size) noexcept {
+        return std::max({ required, capacity * 2, MinInitialCapacity(elem_size) });
+    }
+};
+
+//   1.5 :  ,    ,   
+//          
+struct OneAndHalfGrowth {
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t elem_size) noexcept {
+        return std::max({ required, capacity + capacity / 2, MinInitialCapacity(elem_size) });
+    }
+};
+
+//   2          :  SMALL_LIMIT 
+//    (  Pool    malloc),  -   .
+// ,        ,   
+struct SizeClassGrowth {
+    static constexpr size_t SMALL_LIMIT = 4096;
+    static constexpr size_t PAGE_SIZE = 4096;
+
+    static constexpr size_t NextCapacity(size_t capacity, size_t required, size_t elem_size) noexcept {
+        const size_t bytes = DoublingGrowth::NextCapacity(capacity, required, elem_size) * elem_size;
+        size_t rounded = PAGE_SIZE;
+        if (bytes <= SMALL_LIMIT) {
+            rounded = MIN_INITIAL_BYTES;
+            while (rounded < bytes) {
+                rounded *= 2;
+            }
+        }
+        else {
+            rounded = (bytes + PAGE_SIZE - 1) / PAGE_SIZE * PAGE_SIZE;
+        }
+        return rounded / elem_size;
+    }
+};
+
+//         .    
+//   static size_t ShrinkCapacity(size_t capacity, size_t size, size_t elem_size)
+//    ,    capacity (   size)
+template <typename Growth, typename = void>
+struct has_shrink_capacity : std::false_type {};
+
+template <typename Growth>
+struct has_shrink_capacity<Growth, std::void_t<decltype(Growth::ShrinkCapacity(size_t{}, size_t{}, size_t{}))>>
+    : std::true_type {};
+
+template <typename Growth>
+inline constexpr bool has_shrink_capacity_v = has_shrink_capacity<Growth>::value;
+
+//    Base  ,    1/SHRINK_DIVISOR .  
+//   ,        :  
+//          
+template <typename Base = DoublingGrowth, size_t SHRINK_DIVISOR = 4>
+struct ShrinkingGrowth : Base {
+    static_assert(SHRINK_DIVISOR > 2, "shrinking to twice the size must leave room before the next shrink");
+
+    static constexpr size_t ShrinkCapacity(size_t capacity, size_t size, size_t elem_size) noexcept {
+        const size_t min_capacity = MinInitialCapacity(elem_size);
+        if (capacity <= min_capacity || size >= capacity / SHRINK_DIVISOR) {
+            return capacity;
+        }
+        return std::max(size * 2, min_capacity);
+    }
+};
+
+//    ,     ,   :
+//      ,     
+struct DefaultInitTag {
+    explicit DefaultInitTag() = default;
+};
+
+inline constexpr DefaultInitTag DEFAULT_INIT{};
+
+// Stats -   (. vector_stats.h).    ,
+//  NoStats      
+template <typename T, typename Alloc = std::allocator<T>, typename Growth = DoublingGrowth, typename Stats = NoStats>
+class Vector : private Stats {
+    using AllocTraits = std::allocator_traits<Alloc>;
+
+    template <typename It>
+    using RequireInputIterator = std::enable_if_t<
+        std::is_convertible_v<typename std::iterator_traits<It>::iterator_category, std::input_iterator_tag>>;
+
 public:
+    using value_type = T;
+#if VECTOR_HARDENED
+    using iterator = CheckedIterator<T, Vector>;
+    using const_iterator = CheckedIterator<const T, Vector>;
+#else
     using iterator = T*;
     using const_iterator = const T*;
+#endif
+    using allocator_type = Alloc;
 
     Vector() = default;
 
-    explicit Vector(size_t size)
-        : data_(size)
+    VECTOR_CONSTEXPR explicit Vector(const Alloc& alloc) noexcept
+        : data_(alloc) {
+    }
+
+    VECTOR_CONSTEXPR explicit Vector(size_t size, const Alloc& alloc = Alloc())
+        : data_(size, alloc)
+        , size_(size)
+    {
+        CountAllocation(size);
+        UninitializedValueConstructN(data_.GetAddress(), size);
+    }
+
+    Vector(size_t size, DefaultInitTag, const Alloc& alloc = Alloc())
+        : data_(size, alloc)
+        , size_(size)
+    {
+        CountAllocation(size);
+        std::uninitialized_default_construct_n(data_.GetAddress(), size);
+    }
+
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    VECTOR_CONSTEXPR Vector(InputIt first, InputIt last, const Alloc& alloc = Alloc())
+        : data_(alloc)
+    {
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_convertible_v<Category, std::forward_iterator_tag>) {
+            const auto count = static_cast<size_t>(std::distance(first, last));
+            RawMemory<T, Alloc> new_data(count, data_.GetAllocator());
+            UninitializedCopyN(first, count, new_data.GetAddress());
+            data_.Swap(new_data);
+            size_ = count;
+            CountAllocation(count);
+        }
+        else {
+            //  :   ,    .
+            //    ,   ,   
+            try {
+                for (; first != last; ++first) {
+                    EmplaceBack(*first);
+                }
+            }
+            catch (...) {
+                AnnotateCapacity(size_, data_.Capacity());
+                std::destroy_n(data_.GetAddress(), size_);
+                throw;
+            }
+        }
+    }
+
+    VECTOR_CONSTEXPR Vector(std::initializer_list<T> init, const Alloc& alloc = Alloc())
+        : Vector(init.begin(), init.end(), alloc)
+    {
+    }
+
+    //           
+    Vector(const ParallelPolicy& policy, size_t size, const Alloc& alloc = Alloc())
+        : data_(size, alloc)
         , size_(size)
     {
-        std::uninitialized_value_construct_n(data_.GetAddress(), size);
+        CountAllocation(size);
+        ParallelUninitializedConstruct(policy, data_.GetAddress(), size, [](T* first, size_t n) {
+            std::uninitialized_value_construct_n(first, n);
+        });
+    }
+
+    Vector(const ParallelPolicy& policy, const Vector& other)
+        : data_(other.size_, AllocTraits::select_on_container_copy_construction(other.GetAllocator()))
+        , size_(other.size_)
+    {
+        CountAllocation(size_);
+        const T* src = other.data_.GetAddress();
+        T* dst = data_.GetAddress();
+        ParallelUninitializedConstruct(policy, dst, size_, [src, dst](T* first, size_t n) {
+            std::uninitialized_copy_n(src + (first - dst), n, first);
+        });
+    }
+
+    VECTOR_CONSTEXPR Vector(const Vector& other)
+        : Vector(other, AllocTraits::select_on_container_copy_construction(other.GetAllocator()))
+    {
     }
 
-    Vector(const Vector& other)
-        : data_(other.size_)
+    VECTOR_CONSTEXPR Vector(const Vector& other, const Alloc& alloc)
+        : data_(other.size_, alloc)
         , size_(other.size_)
     {
-        std::uninitialized_copy_n(other.data_.GetAddress(), other.size_, data_.GetAddress());
+        CountAllocation(size_);
+        UninitializedCopyN(other.data_.GetAddress(), other.size_, data_.GetAddress());
     }
 
+    //  ,    rhs, . AssignN.    
+    //    ,   ,      - 
     Vector& operator=(const Vector& rhs) {
         if (this != &rhs) {
-            if (rhs.size_ > data_.Capacity()) {
-                Vector crhs(rhs);
-                Swap(crhs);
-            }
-            else {
-                size_t new_size = std::min(size_, rhs.size_);
-                std::copy(rhs.data_.GetAddress(), rhs.data_.GetAddress() + new_size, data_.GetAddress());
-
-                if (rhs.size_ < size_) {
-                    std::destroy_n(data_.GetAddress() + new_size, size_ - new_size);
-                }
-                else if (rhs.size_ > size_) {
-                    std::uninitialized_copy_n(rhs.data_.GetAddress() + size_, rhs.size_ - size_, data_.GetAddress() + size_);
-                }
-                size_ = rhs.size_;
-            }
+            const MutationScope scope(*this);
+            PropagateCopyAllocator(rhs);
+            AssignN(rhs.data_.GetAddress(), rhs.size_);
         }
         return *this;
     }
 
-    Vector(Vector&& rhs) noexcept {
-        Swap(rhs);
+    VECTOR_CONSTEXPR Vector(Vector&& rhs) noexcept
+        : data_(std::move(rhs.data_))
+        , size_(std::exchange(rhs.size_, 0))
+    {
+        rhs.InvalidateIterators();
     }
 
-    Vector& operator=(Vector&& rhs) noexcept {
+    VECTOR_CONSTEXPR Vector& operator=(Vector&& rhs) noexcept(AllocTraits::propagate_on_container_move_assignment::value
+                                             || AllocTraits::is_always_equal::value) {
         if (this != &rhs) {
-            Swap(rhs);
+            if constexpr (AllocTraits::propagate_on_container_move_assignment::value
+                          || AllocTraits::is_always_equal::value) {
+                SwapBuffers(rhs);
+            }
+            else if (GetAllocator() == rhs.GetAllocator()) {
+                SwapBuffers(rhs);
+            }
+            else {
+                //  rhs   ,    -  
+                const MutationScope scope(*this);
+                AssignN(std::make_move_iterator(rhs.data_.GetAddress()), rhs.size_);
+            }
         }
         return *this;
     }
 
-
-    ~Vector() {
+    VECTOR_CONSTEXPR ~Vector() {
+        if constexpr (has_on_final_size_v<Stats>) {
+            //          
+            if (size_ != 0) {
+                MutableStats().OnFinalSize(size_);
+            }
+        }
+        AnnotateCapacity(size_, data_.Capacity());
         std::destroy_n(data_.GetAddress(), size_);
     }
 
-    const T& operator[](size_t index) const noexcept {
+    VECTOR_CONSTEXPR const T& operator[](size_t index) const noexcept {
         return const_cast<Vector&>(*this)[index];
     }
 
-    T& operator[](size_t index) noexcept {
-        assert(index < size_);
+    VECTOR_CONSTEXPR T& operator[](size_t index) noexcept {
+        VECTOR_CHECK(index < size_, "Vector index out of range");
         return data_[index];
     }
-    size_t Size() const noexcept {
+
+    // operator[],      .  index >= Size()  std::out_of_range
+    VECTOR_CONSTEXPR const T& At(size_t index) const {
+        return const_cast<Vector&>(*this).At(index);
+    }
+
+    VECTOR_CONSTEXPR T& At(size_t index) {
+        if (index >= size_) {
+            throw std::out_of_range("Vector::At: index out of range");
+        }
+        return data_[index];
+    }
+
+    //   .   ,    ,  
+    VECTOR_CONSTEXPR T* Data() noexcept {
+        return data_.GetAddress();
+    }
+
+    VECTOR_CONSTEXPR const T* Data() const noexcept {
+        return data_.GetAddress();
+    }
+
+    VECTOR_CONSTEXPR size_t Size() const noexcept {
         return size_;
     }
 
-    size_t Capacity() const noexcept {
+    VECTOR_CONSTEXPR size_t Capacity() const noexcept {
         return data_.Capacity();
     }
 
-    void Reserve(size_t new_capacity) {
+    VECTOR_CONSTEXPR Alloc GetAllocator() const noexcept {
+        return data_.GetAllocator();
+    }
+
+    VECTOR_CONSTEXPR const Stats& GetStats() const noexcept {
+        return *this;
+    }
+
+    //     new_capacity,   .     :
+    //  Reserve(Size() + k)     ,    ReserveAtLeast
+    VECTOR_CONSTEXPR void Reserve(size_t new_capacity) {
         if (new_capacity <= data_.Capacity()) {
             return;
         }
-        RawMemory<T> new_data(new_capacity);
-        if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
-            std::uninitialized_move_n(data_.GetAddress(), size_, new_data.GetAddress());
-        }
-        else {
-            std::uninitialized_copy_n(data_.GetAddress(), size_, new_data.GetAddress());
+        const MutationScope scope(*this);
+        if constexpr (is_trivially_relocatable_v<T> && RawMemory<T, Alloc>::CAN_GROW) {
+            if (GrowBuffer(new_capacity)) {
+                return;
+            }
         }
-        //    data_
-        std::destroy_n(data_.GetAddress(), size_);
-        //     ,    
-        data_.Swap(new_data);
+        Reallocate(new_capacity);
     }
 
-    void Swap(Vector& other) noexcept {
-        std::swap(data_, other.data_);
-        std::swap(size_, other.size_);
+    //  ,  Reserve:   new_capacity,     
+    VECTOR_CONSTEXPR void ReserveExact(size_t new_capacity) {
+        Reserve(new_capacity);
     }
 
-    void Resize(size_t new_size) {
-        if (new_size < size_) {
-            std::destroy_n(data_.GetAddress() + new_size, size_ - new_size);
-            size_ = new_size;
-        }
-        else {
-            Reserve(new_size);
-            std::uninitialized_value_construct_n(data_.GetAddress() + size_, new_size - size_);
-            size_ = new_size;
+    //     min_capacity     Growth,   :
+    //  ReserveAtLeast(Size() + k)   O(1)  
+    VECTOR_CONSTEXPR void ReserveAtLeast(size_t min_capacity) {
+        if (min_capacity > data_.Capacity()) {
+            Reserve(NextCapacity(min_capacity));
         }
     }
-    template <typename Total>
-    void PushBack(Total&& value) {
-        EmplaceBack(std::forward<Total>(value));
-    }
 
-    template <typename... Args>
-    T& EmplaceBack(Args&&... args) {
-        T* res = nullptr;
+    //    .     
+    void ShrinkToFit() {
         if (size_ < data_.Capacity()) {
-            res = new (data_ + size_) T(std::forward<Args>(args)...);
-            ++size_;
+            Reallocate(size_);
         }
-        else {
-            RawMemory<T> new_data(size_ == 0 ? 1 : size_ * 2);
-            res = new (new_data + size_) T(std::forward<Args>(args)...);
-            if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
-                std::uninitialized_move_n(data_.GetAddress(), size_, new_data.GetAddress());
-            }
-            else {
-                try {
-                    std::uninitialized_copy_n(data_.GetAddress(), size_, new_data.GetAddress());
-                }
-                catch (...) {
-                    std::destroy_n(new_data.GetAddress() + size_, 1);
-                    throw;
-                }
-            }
-            std::destroy_n(data_.GetAddress(), size_);
-            data_.Swap(new_data);
+    }
+
+    //   ,     
+    VECTOR_CONSTEXPR void Clear() noexcept {
+        const MutationScope scope(*this);
+        std::destroy_n(data_.GetAddress(), size_);
+        size_ = 0;
+    }
+
+    // ,    Release
+    struct Buffer {
+        T* data;
+        size_t size;
+        size_t capacity;
+    };
+
+    //       ptr  capacity,   
+    //  size .   ,   . 
+    //  alloc,    
+    void Adopt(T* ptr, size_t size, size_t capacity, const Alloc& alloc) noexcept {
+        assert(size <= capacity && (ptr != nullptr || capacity == 0));
+        const MutationScope scope(*this);
+        Clear();
+        RawMemory<T, Alloc>(ptr, capacity, alloc).Swap(data_);
+        InvalidateIterators();
+        size_ = size;
+    }
+
+    //  ptr  ,   
+    void Adopt(T* ptr, size_t size, size_t capacity) noexcept {
+        Adopt(ptr, size, capacity, GetAllocator());
+    }
+
+    //    deleter ,    ExternalBufferAllocator,
+    //       .     ,  
+    //  
+    template <typename Deleter, typename = std::enable_if_t<std::is_constructible_v<Alloc, T*, Deleter>>>
+    void Adopt(T* ptr, size_t size, size_t capacity, Deleter deleter) {
+        Adopt(ptr, size, capacity, Alloc(ptr, std::move(deleter)));
+    }
+
+    //          .  
+    //      GetAllocator()
+    Buffer Release() noexcept {
+        const MutationScope scope(*this);
+        const Buffer buffer{ data_.GetAddress(), size_, data_.Capacity() };
+        data_.Release();
+        InvalidateIterators();
+        size_ = 0;
+        return buffer;
+    }
+
+    //   , ,    
+    Span<T> View() noexcept {
+        return { data_.GetAddress(), size_ };
+    }
+
+    Span<const T> View() const noexcept {
+        return { data_.GetAddress(), size_ };
+    }
+
+    //       , ,   RecyclingAllocator
+    void Reset() noexcept {
+        const MutationScope scope(*this);
+        Clear();
+        RawMemory<T, Alloc>(data_.GetAllocator()).Swap(data_);
+        InvalidateIterators();
+    }
+
+    VECTOR_CONSTEXPR void Swap(Vector& other) noexcept {
+        if constexpr (!AllocTraits::propagate_on_container_swap::value) {
+            //        
+            assert(GetAllocator() == other.GetAllocator());
+        }
+        SwapBuffers(other);
+    }
+
+    void Resize(size_t new_size) {
+        const MutationScope scope(*this);
+        if (new_size < size_) {
+            std::destroy_n(data_.GetAddress() + new_size, size_ - new_size);
+            size_ = new_size;
+            MaybeShrink();
+        }
+        else {
+            ReserveAtLeast(new_size);
+            std::uninitialized_value_construct_n(data_.GetAddress() + size_, new_size - size_);
+            size_ = new_size;
+        }
+    }
+
+    // Resize,      
+    void Resize(const ParallelPolicy& policy, size_t new_size) {
+        if (new_size <= size_) {
+            Resize(new_size);
+            return;
+        }
+        const MutationScope scope(*this);
+        ReserveAtLeast(new_size);
+        ParallelUninitializedConstruct(policy, data_.GetAddress() + size_, new_size - size_, [](T* first, size_t n) {
+            std::uninitialized_value_construct_n(first, n);
+        });
+        size_ = new_size;
+    }
+
+    //  Resize,      :    
+    //        
+    void ResizeDefaultInit(size_t new_size) {
+        const MutationScope scope(*this);
+        if (new_size < size_) {
+            std::destroy_n(data_.GetAddress() + new_size, size_ - new_size);
+            size_ = new_size;
+            MaybeShrink();
+        }
+        else {
+            ReserveAtLeast(new_size);
+            std::uninitialized_default_construct_n(data_.GetAddress() + size_, new_size - size_);
+            size_ = new_size;
+        }
+    }
+
+    //  std::string::resize_and_overwrite:     count  
+    // op(data, count),     [data, data + count)    
+    // (  count).        
+    template <typename Operation>
+    void ResizeAndOverwrite(size_t count, Operation op) {
+        static_assert(std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>,
+                      "ResizeAndOverwrite requires elements that need no construction or destruction");
+        const MutationScope scope(*this);
+        Reserve(count);
+        const size_t new_size = std::move(op)(data_.GetAddress(), count);
+        assert(new_size <= count);
+        size_ = new_size;
+    }
+    template <typename Total>
+    VECTOR_CONSTEXPR void PushBack(Total&& value) {
+        EmplaceBack(std::forward<Total>(value));
+    }
+
+    template <typename... Args>
+    VECTOR_CONSTEXPR T& EmplaceBack(Args&&... args) {
+        const MutationScope scope(*this);
+        T* res = nullptr;
+        if (size_ < data_.Capacity()) {
+            res = ConstructAt(data_ + size_, std::forward<Args>(args)...);
+            ++size_;
+        }
+        else {
+            ReallocateAndEmplace(size_, std::forward<Args>(args)...);
+            res = data_ + size_;
             ++size_;
         }
         return *res;
     }
 
-    void PopBack() /* noexcept */ {
+    VECTOR_CONSTEXPR void PopBack() /* noexcept */ {
+        VECTOR_CHECK(size_ != 0, "PopBack on empty Vector");
+        const MutationScope scope(*this);
         std::destroy_at(data_.GetAddress() + size_ - 1);
         --size_;
+        MaybeShrink();
     }
 
+    //  ,   args,  pos.       
+    //  (. ArgsMayAlias),      .    T
+    //   memmove,  T - 
     template <typename... Args>
     iterator Emplace(const_iterator pos, Args&&... args) {
-        if (pos == end()) return &EmplaceBack(std::forward<Args&&>(args)...);
-        size_t index = pos - begin();
-        if (size_ < data_.Capacity()) {
-            T tmp(std::forward<Args>(args)...);
-            new (end()) T(std::forward<T>(*(end() - 1)));
-            try {
-                std::move_backward(begin() + index, end() - 1, end());
-            }
-            catch (...) {
-                std::destroy_n(end(), 1);
-                throw;
-            }
-            data_[index] = std::move(tmp);
+        const size_t index = pos - cbegin();
+        CheckPosition(index);
+        if (index == size_) {
+            EmplaceBack(std::forward<Args>(args)...);
+            return begin() + index;
         }
-        else {
-            if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
-                ReallocateWithMove(index, std::forward<Args>(args)...);
+        const MutationScope scope(*this);
+        if (size_ == data_.Capacity()) {
+            ReallocateAndEmplace(index, std::forward<Args>(args)...);
+        }
+        else if constexpr (is_trivially_relocatable_v<T>) {
+            T* gap = data_ + index;
+            const size_t tail = size_ - index;
+            if (!ArgsMayAlias(data_.GetAddress(), size_, args...)) {
+                std::memmove(static_cast<void*>(gap + 1), static_cast<const void*>(gap), tail * sizeof(T));
+                try {
+                    new (gap) T(std::forward<Args>(args)...);
+                }
+                catch (...) {
+                    std::memmove(static_cast<void*>(gap), static_cast<const void*>(gap + 1), tail * sizeof(T));
+                    throw;
+                }
             }
             else {
-                ReallocateWithCopy(index, std::forward<Args>(args)...);
+                //    ,    ,   
+                //       
+                alignas(T) unsigned char storage[sizeof(T)];
+                T* elem = new (storage) T(std::forward<Args>(args)...);
+                std::memmove(static_cast<void*>(gap + 1), static_cast<const void*>(gap), tail * sizeof(T));
+                UninitializedRelocateN(elem, 1, gap);
             }
         }
+        else if (std::is_nothrow_constructible_v<T, Args&&...> && !ArgsMayAlias(data_.GetAddress(), size_, args...)) {
+            ShiftTail(index);
+            //         
+            std::destroy_at(data_ + index);
+            new (data_ + index) T(std::forward<Args>(args)...);
+        }
+        else {
+            T tmp(std::forward<Args>(args)...);
+            ShiftTail(index);
+            data_[index] = std::move(tmp);
+        }
         ++size_;
         return begin() + index;
     }
 
-    template <typename... Args>
-    void ReallocateWithCopy(size_t index, Args&&... args) {
-        RawMemory<T> new_data(size_ == 0 ? 1 : size_ * 2);
-        new (new_data + index) T(std::forward<Args>(args)...);
+    iterator Erase(const_iterator pos) /*noexcept(std::is_nothrow_move_assignable_v<T>)*/ {
+        return Erase(pos, pos + 1);
+    }
 
-        try {
-            std::uninitialized_copy_n(begin(), index, new_data.GetAddress());
-            std::uninitialized_copy_n(begin() + index, size_ - index, new_data.GetAddress() + index + 1);
+    //   [first, last),    .   
+    //   ,  -  
+    iterator Erase(const_iterator first, const_iterator last) {
+        const size_t index = first - cbegin();
+        const size_t count = last - first;
+        VECTOR_CHECK(index <= size_ && count <= size_ - index, "Erase range out of range");
+        if (count == 0) {
+            return begin() + index;
         }
-        catch (...) {
-            std::destroy_n(new_data.GetAddress() + index, 1);
-            throw;
+        const MutationScope scope(*this);
+        T* const erased = data_ + index;
+        T* const old_end = data_ + size_;
+        if constexpr (is_trivially_relocatable_v<T>) {
+            const size_t tail = size_ - index - count;
+            std::destroy_n(erased, count);
+            std::memmove(static_cast<void*>(erased), static_cast<const void*>(erased + count), tail * sizeof(T));
         }
-
-        std::destroy_n(begin(), size_);
-        data_.Swap(new_data);
+        else {
+            std::move(erased + count, old_end, erased);
+            std::destroy_n(old_end - count, count);
+        }
+        size_ -= count;
+        MaybeShrink();
+        return begin() + index;
     }
 
-    template <typename... Args>
-    void ReallocateWithMove(size_t index, Args&&... args) {
-        RawMemory<T> new_data(size_ == 0 ? 1 : size_ * 2);
-        new (new_data + index) T(std::forward<Args>(args)...);
+    //    [first, last),      .
+    //  ,    , . AssignN
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    void Assign(InputIt first, InputIt last) {
+        const MutationScope scope(*this);
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_convertible_v<Category, std::forward_iterator_tag>) {
+            AssignN(first, static_cast<size_t>(std::distance(first, last)));
+        }
+        else {
+            Clear();
+            for (; first != last; ++first) {
+                EmplaceBack(*first);
+            }
+        }
+    }
 
-        std::uninitialized_move_n(begin(), index, new_data.GetAddress());
-        std::uninitialized_move_n(begin() + index, size_ - index, new_data.GetAddress() + index + 1);
+    //   count  value. value      
+    void Assign(size_t count, const T& value) {
+        const MutationScope scope(*this);
+        if (IsElement(value)) {
+            const T copy(value);
+            AssignN(RepeatIterator(copy), count);
+        }
+        else {
+            AssignN(RepeatIterator(value), count);
+        }
+    }
 
-        std::destroy_n(begin(), size_);
-        data_.Swap(new_data);
+    void Assign(std::initializer_list<T> init) {
+        Assign(init.begin(), init.end());
     }
 
-    iterator Erase(const_iterator pos) /*noexcept(std::is_nothrow_move_assignable_v<T>)*/ {
-        iterator it_pos = const_cast<iterator>(pos);
-        std::move(it_pos + 1, end(), it_pos);
-        std::destroy_at(data_.GetAddress() + size_ - 1);
-        --size_;
-        return it_pos;
+    //  ,     .   
+    //  operator=:       .  -
+    //   ,   ,    
+    void Assign(const ParallelPolicy& policy, const Vector& other) {
+        if (this == &other) {
+            return;
+        }
+        const MutationScope scope(*this);
+        PropagateCopyAllocator(other);
+        if (other.size_ > data_.Capacity()) {
+            const size_t new_capacity = NextCapacity(other.size_);
+            Reset();
+            RawMemory<T, Alloc> new_data(new_capacity, data_.GetAllocator());
+            CountAllocation(new_capacity);
+            data_.Swap(new_data);
+        }
+        else {
+            Clear();
+        }
+        const T* src = other.data_.GetAddress();
+        T* dst = data_.GetAddress();
+        ParallelUninitializedConstruct(policy, dst, other.size_, [src, dst](T* first, size_t n) {
+            std::uninitialized_copy_n(src + (first - dst), n, first);
+        });
+        size_ = other.size_;
     }
+
     iterator Insert(const_iterator pos, const T& value) { return Emplace(pos, value); }
     iterator Insert(const_iterator pos, T&& value) { return Emplace(pos, std::move(value)); }
 
-    iterator begin() noexcept {
-        return data_.GetAddress();
+    //  count  value  pos.      ,
+    //    . value      
+    iterator Insert(const_iterator pos, size_t count, const T& value) {
+        const size_t index = pos - cbegin();
+        CheckPosition(index);
+        const MutationScope scope(*this);
+        if (IsElement(value)) {
+            const T copy(value);
+            return InsertN(index, RepeatIterator(copy), count);
+        }
+        return InsertN(index, RepeatIterator(value), count);
+    }
+
+    //   pos   [first, last),      .
+    //      ,      
+    //    .   (    T - ) 
+    //   ,     ,    
+    template <typename InputIt, typename = RequireInputIterator<InputIt>>
+    iterator Insert(const_iterator pos, InputIt first, InputIt last) {
+        const size_t index = pos - cbegin();
+        CheckPosition(index);
+        const MutationScope scope(*this);
+        using Category = typename std::iterator_traits<InputIt>::iterator_category;
+        if constexpr (std::is_convertible_v<Category, std::forward_iterator_tag>) {
+            return InsertN(index, first, static_cast<size_t>(std::distance(first, last)));
+        }
+        else if (index == size_) {
+            for (; first != last; ++first) {
+                EmplaceBack(*first);
+            }
+            return begin() + index;
+        }
+        else {
+            Vector buffer(first, last, data_.GetAllocator());
+            return InsertN(index, std::make_move_iterator(buffer.Data()), buffer.Size());
+        }
     }
-    iterator end() noexcept {
-        return data_.GetAddress() + size_;
+
+    iterator Insert(const_iterator pos, std::initializer_list<T> init) {
+        return Insert(pos, init.begin(), init.end());
+    }
+
+    //     comp  [first, last)    comp ;
+    //     .      . comp  
+    //  ,      .    T
+    //       , O(Size() + k log Size())  O(k Size())  k 
+    //  ,        .  T 
+    //     std::inplace_merge:        
+    //    
+    template <typename ForwardIt, typename Compare = std::less<>>
+    void InsertSorted(ForwardIt first, ForwardIt last, Compare comp = Compare()) {
+        assert(std::is_sorted(first, last, comp));
+        const auto count = static_cast<size_t>(std::distance(first, last));
+        if (count == 0) {
+            return;
+        }
+        const MutationScope scope(*this);
+        if (size_ + count > data_.Capacity()) {
+            Reserve(NextCapacity(size_ + count));
+        }
+        if constexpr (is_trivially_relocatable_v<T>) {
+            //           :   
+            //      memmove,      
+            RawMemory<T, Alloc> keys(count, data_.GetAllocator());
+            std::uninitialized_copy_n(first, count, keys.GetAddress());
+            T* const base = data_.GetAddress();
+            size_t old_end = size_;
+            for (size_t j = count; j > 0; --j) {
+                T* pos = std::upper_bound(base, base + old_end, keys[j - 1], comp);
+                std::memmove(static_cast<void*>(pos + j), static_cast<const void*>(pos),
+                             (base + old_end - pos) * sizeof(T));
+                UninitializedRelocateN(keys + (j - 1), 1, pos + j - 1);
+                old_end = pos - base;
+            }
+            size_ += count;
+        }
+        else {
+            const size_t old_size = size_;
+            Insert(cend(), first, last);
+            std::inplace_merge(Data(), Data() + old_size, Data() + size_, comp);
+        }
     }
-    const_iterator begin() const noexcept {
+
+    //      range.    
+    template <typename Range>
+    void Append(Range&& range) {
+        if constexpr (std::is_rvalue_reference_v<Range&&>) {
+            Insert(cend(), std::make_move_iterator(std::begin(range)), std::make_move_iterator(std::end(range)));
+        }
+        else {
+            Insert(cend(), std::begin(range), std::end(range));
+        }
+    }
+
+    VECTOR_CONSTEXPR iterator begin() noexcept {
+        return MakeIterator(data_.GetAddress());
+    }
+    VECTOR_CONSTEXPR iterator end() noexcept {
+        return MakeIterator(data_.GetAddress() + size_);
+    }
+    VECTOR_CONSTEXPR const_iterator begin() const noexcept {
         return cbegin();
     }
-    const_iterator end() const noexcept {
+    VECTOR_CONSTEXPR const_iterator end() const noexcept {
         return cend();
     }
-    const_iterator cbegin() const noexcept {
-        return data_.GetAddress();
+    VECTOR_CONSTEXPR const_iterator cbegin() const noexcept {
+        return MakeIterator(data_.GetAddress());
     }
-    const_iterator cend() const noexcept {
-        return data_.GetAddress() + size_;
+    VECTOR_CONSTEXPR const_iterator cend() const noexcept {
+        return MakeIterator(data_.GetAddress() + size_);
+    }
+
+protected:
+    //       new_capacity >= Size().     
+    VECTOR_CONSTEXPR void Reallocate(size_t new_capacity) {
+        assert(new_capacity >= size_);
+        const MutationScope scope(*this);
+        RawMemory<T, Alloc> new_data(new_capacity, data_.GetAllocator());
+        CountAllocation(new_capacity);
+        //    data_  new_data,  
+        UninitializedRelocateN(data_.GetAddress(), size_, new_data.GetAddress());
+        CountRelocation(size_);
+        //     ,    
+        data_.Swap(new_data);
+        InvalidateIterators();
     }
 
 private:
-    RawMemory<T> data_;
+#if VECTOR_HARDENED
+    template <typename, typename>
+    friend class CheckedIterator;
+
+    VECTOR_CONSTEXPR size_t IteratorGeneration() const noexcept {
+        return generation_;
+    }
+#endif
+
+    VECTOR_CONSTEXPR iterator MakeIterator(T* ptr) noexcept {
+#if VECTOR_HARDENED
+        return iterator(ptr, this, generation_);
+#else
+        return ptr;
+#endif
+    }
+
+    VECTOR_CONSTEXPR const_iterator MakeIterator(const T* ptr) const noexcept {
+#if VECTOR_HARDENED
+        return const_iterator(ptr, this, generation_);
+#else
+        return ptr;
+#endif
+    }
+
+    //     :       
+    VECTOR_CONSTEXPR void InvalidateIterators() noexcept {
+#if VECTOR_HARDENED
+        ++generation_;
+#endif
+    }
+
+    VECTOR_CONSTEXPR void SwapBuffers(Vector& other) noexcept {
+        data_.Swap(other.data_);
+        std::swap(size_, other.size_);
+        InvalidateIterators();
+        other.InvalidateIterators();
+    }
+
+    VECTOR_CONSTEXPR void CheckPosition([[maybe_unused]] size_t index) const noexcept {
+        VECTOR_CHECK(index <= size_, "Vector position out of range");
+    }
+
+    //   value    
+    bool IsElement(const T& value) const noexcept {
+        const T* first = data_.GetAddress();
+        return std::less_equal<const T*>()(first, &value) && std::less<const T*>()(&value, first + size_);
+    }
+
+    //  ASan,       [0, old_mid)  [0, new_mid)
+    VECTOR_CONSTEXPR void AnnotateCapacity([[maybe_unused]] size_t old_mid, [[maybe_unused]] size_t new_mid) const noexcept {
+#if VECTOR_ANNOTATE_CONTAINER
+        const T* first = data_.GetAddress();
+        if (!IsConstantEvaluated() && first != nullptr) {
+            AnnotateContiguousContainer(first, first + data_.Capacity(), first + old_mid, first + new_mid);
+        }
+#endif
+    }
+
+    //   ,    :    Size() 
+    //  ,      ,     
+    //  .          .
+    //  VECTOR_ANNOTATE_CONTAINER  
+    class MutationScope {
+    public:
+#if VECTOR_ANNOTATE_CONTAINER
+        VECTOR_CONSTEXPR explicit MutationScope(Vector& v) noexcept
+            : vector_(v)
+            , outer_(!v.mutating_) {
+            if (outer_) {
+                vector_.AnnotateCapacity(vector_.size_, vector_.data_.Capacity());
+                vector_.mutating_ = true;
+            }
+        }
+
+        MutationScope(const MutationScope&) = delete;
+        MutationScope& operator=(const MutationScope&) = delete;
+
+        VECTOR_CONSTEXPR ~MutationScope() {
+            if (outer_) {
+                vector_.mutating_ = false;
+                vector_.AnnotateCapacity(vector_.data_.Capacity(), vector_.size_);
+            }
+        }
+
+    private:
+        Vector& vector_;
+        bool outer_;
+#else
+        VECTOR_CONSTEXPR explicit MutationScope(Vector& /*v*/) noexcept {
+        }
+#endif
+    };
+
+    //     index    ,   .  index
+    //    ,   
+    void ShiftTail(size_t index) {
+        T* const end = data_ + size_;
+        new (end) T(std::move(*(end - 1)));
+        try {
+            std::move_backward(data_ + index, end - 1, end);
+        }
+        catch (...) {
+            std::destroy_at(end);
+            throw;
+        }
+    }
+
+    //  ,     .  -   ,
+    //           
+    VECTOR_CONSTEXPR void MaybeShrink() noexcept {
+        if constexpr (has_shrink_capacity_v<Growth>) {
+            const size_t new_capacity = Growth::ShrinkCapacity(data_.Capacity(), size_, sizeof(T));
+            if (new_capacity < data_.Capacity()) {
+                try {
+                    Reallocate(std::max(new_capacity, size_));
+                }
+                catch (...) {
+                }
+            }
+        }
+    }
+
+    //   required    .     
+    //  ,    
+    VECTOR_CONSTEXPR size_t NextCapacity(size_t required) const noexcept {
+        const size_t capacity = Growth::NextCapacity(data_.Capacity(), required, sizeof(T));
+        if constexpr (has_capacity_hint_v<Stats>) {
+            if (data_.Capacity() == 0) {
+                return std::max(capacity, static_cast<size_t>(GetStats().CapacityHint()));
+            }
+        }
+        return capacity;
+    }
+
+    VECTOR_CONSTEXPR Stats& MutableStats() noexcept {
+        return *this;
+    }
+
+    //        capacity
+    VECTOR_CONSTEXPR void CountAllocation(size_t capacity) noexcept {
+        if (capacity != 0) {
+            MutableStats().OnAllocate(capacity, capacity * sizeof(T));
+        }
+    }
+
+    //      count     
+    VECTOR_CONSTEXPR void CountRelocation(size_t count) noexcept {
+        if (count != 0) {
+            MutableStats().OnReallocate();
+            MutableStats().OnRelocate(count, RELOCATION_KIND<T>);
+        }
+    }
+
+    // RawMemory::Grow    .       
+    bool GrowBuffer(size_t new_capacity) {
+        const bool had_elements = size_ != 0;
+        if (!data_.Grow(new_capacity)) {
+            return false;
+        }
+        InvalidateIterators();
+        CountAllocation(new_capacity);
+        if (had_elements) {
+            MutableStats().OnReallocate();
+        }
+        return true;
+    }
+
+    //  ,       
+    class RepeatIterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        explicit RepeatIterator(const T& value) noexcept
+            : value_(&value) {
+        }
+
+        reference operator*() const noexcept {
+            return *value_;
+        }
+        RepeatIterator& operator++() noexcept {
+            return *this;
+        }
+        RepeatIterator operator++(int) noexcept {
+            return *this;
+        }
+
+    private:
+        const T* value_;
+    };
+
+    //    index count ,   src
+    template <typename ForwardIt>
+    iterator InsertN(size_t index, ForwardIt src, size_t count) {
+        if (count == 0) {
+            return begin() + index;
+        }
+        const size_t tail = size_ - index;
+        if (size_ + count > data_.Capacity()) {
+            const size_t new_capacity = NextCapacity(size_ + count);
+            bool grown = false;
+            if constexpr (is_trivially_relocatable_v<T> && RawMemory<T, Alloc>::CAN_GROW) {
+                grown = GrowBuffer(new_capacity);
+            }
+            if (!grown) {
+                RawMemory<T, Alloc> new_data(new_capacity, data_.GetAllocator());
+                CountAllocation(new_capacity);
+                std::uninitialized_copy_n(src, count, new_data + index);
+                try {
+                    UninitializedRelocateWithGap(data_.GetAddress(), size_, index, new_data.GetAddress(), count);
+                }
+                catch (...) {
+                    std::destroy_n(new_data + index, count);
+                    throw;
+                }
+                CountRelocation(size_);
+                data_.Swap(new_data);
+                InvalidateIterators();
+                size_ += count;
+                return begin() + index;
+            }
+        }
+        T* gap = data_ + index;
+        if constexpr (is_trivially_relocatable_v<T>) {
+            //   ,      
+            std::memmove(static_cast<void*>(gap + count), static_cast<const void*>(gap), tail * sizeof(T));
+            try {
+                std::uninitialized_copy_n(src, count, gap);
+            }
+            catch (...) {
+                std::memmove(static_cast<void*>(gap), static_cast<const void*>(gap + count), tail * sizeof(T));
+                throw;
+            }
+        }
+        else if (tail > count) {
+            //  count        ,
+            //     ,      
+            std::uninitialized_move_n(gap + tail - count, count, gap + tail);
+            size_ += count;
+            std::move_backward(gap, gap + tail - count, gap + tail);
+            std::copy_n(src, count, gap);
+            return begin() + index;
+        }
+        else {
+            //     ,       
+            ForwardIt mid = std::next(src, tail);
+            std::uninitialized_copy_n(mid, count - tail, gap + tail);
+            try {
+                std::uninitialized_move_n(gap, tail, gap + count);
+            }
+            catch (...) {
+                std::destroy_n(gap + tail, count - tail);
+                throw;
+            }
+            size_ += count;
+            std::copy_n(src, tail, gap);
+            return begin() + index;
+        }
+        size_ += count;
+        return begin() + index;
+    }
+
+    //    ,      index
+    template <typename... Args>
+    VECTOR_CONSTEXPR void ReallocateAndEmplace(size_t index, Args&&... args) {
+        const size_t new_capacity = NextCapacity(size_ + 1);
+        if constexpr (is_trivially_relocatable_v<T> && RawMemory<T, Alloc>::CAN_GROW) {
+            //      ,  Grow   ,
+            //           
+            alignas(T) unsigned char storage[sizeof(T)];
+            T* elem = new (storage) T(std::forward<Args>(args)...);
+            try {
+                if (GrowBuffer(new_capacity)) {
+                    T* base = data_.GetAddress();
+                    std::memmove(static_cast<void*>(base + index + 1), static_cast<const void*>(base + index),
+                                 (size_ - index) * sizeof(T));
+                }
+                else {
+                    RawMemory<T, Alloc> new_data(new_capacity, data_.GetAllocator());
+                    CountAllocation(new_capacity);
+                    UninitializedRelocateWithGap(data_.GetAddress(), size_, index, new_data.GetAddress());
+                    CountRelocation(size_);
+                    data_.Swap(new_data);
+                    InvalidateIterators();
+                }
+            }
+            catch (...) {
+                std::destroy_at(elem);
+                throw;
+            }
+            UninitializedRelocateN(elem, 1, data_ + index);
+        }
+        else {
+            RawMemory<T, Alloc> new_data(new_capacity, data_.GetAllocator());
+            CountAllocation(new_capacity);
+            T* elem = ConstructAt(new_data + index, std::forward<Args>(args)...);
+            try {
+                UninitializedRelocateWithGap(data_.GetAddress(), size_, index, new_data.GetAddress());
+            }
+            catch (...) {
+                std::destroy_at(elem);
+                throw;
+            }
+            CountRelocation(size_);
+            data_.Swap(new_data);
+            InvalidateIterators();
+        }
+    }
+
+    // ,     T   memcpy
+    template <typename It>
+    static constexpr bool IS_MEMCPY_SOURCE = std::is_trivially_copyable_v<T>
+        && (std::is_same_v<It, const T*> || std::is_same_v<It, T*> || std::is_same_v<It, std::move_iterator<T*>>);
+
+    //     to n ,   src
+    template <typename ForwardIt>
+    static void UninitializedCopyFrom(ForwardIt src, size_t n, T* to) {
+        if constexpr (IS_MEMCPY_SOURCE<ForwardIt>) {
+            if (n != 0) {
+                const T* from;
+                if constexpr (std::is_same_v<ForwardIt, std::move_iterator<T*>>) {
+                    from = src.base();
+                }
+                else {
+                    from = src;
+                }
+                std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), n * sizeof(T));
+            }
+        }
+        else {
+            UninitializedCopyN(src, n, to);
+        }
+    }
+
+    //       :    rhs 
+    // ,    ,      rhs
+    void PropagateCopyAllocator(const Vector& rhs) {
+        if constexpr (AllocTraits::propagate_on_container_copy_assignment::value) {
+            if (GetAllocator() != rhs.GetAllocator()) {
+                Clear();
+                RawMemory<T, Alloc>(rhs.GetAllocator()).Swap(data_);
+                InvalidateIterators();
+            }
+        }
+    }
+
+    //   n ,   src.    ,  
+    // .          ,
+    //        .   :
+    //         
+    template <typename ForwardIt>
+    void AssignN(ForwardIt src, size_t n) {
+        if (n > data_.Capacity()) {
+            const size_t new_capacity = NextCapacity(n);
+            Reset();
+            RawMemory<T, Alloc> new_data(new_capacity, data_.GetAllocator());
+            CountAllocation(new_capacity);
+            data_.Swap(new_data);
+            UninitializedCopyFrom(src, n, data_.GetAddress());
+        }
+        else if constexpr (IS_MEMCPY_SOURCE<ForwardIt>) {
+            UninitializedCopyFrom(src, n, data_.GetAddress());
+        }
+        else {
+            const size_t common = std::min(size_, n);
+            std::copy_n(src, common, data_.GetAddress());
+            if (n < size_) {
+                std::destroy_n(data_.GetAddress() + n, size_ - n);
+            }
+            else if (n > size_) {
+                std::uninitialized_copy_n(std::next(src, common), n - common, data_.GetAddress() + common);
+            }
+        }
+        size_ = n;
+    }
+
+    template <typename U, typename A, typename G, typename S, typename Predicate>
+    friend size_t EraseIf(Vector<U, A, G, S>& v, Predicate pred);
+
+    RawMemory<T, Alloc> data_;
     size_t size_ = 0;
-};
\ No newline at end of file
+#if VECTOR_HARDENED
+    size_t generation_ = 0;
+#endif
+#if VECTOR_ANNOTATE_CONTAINER
+    bool mutating_ = false;
+#endif
+};
+
+//   ,  pred,       .
+//    ,    
+template <typename T, typename Alloc, typename Growth, typename Stats, typename Predicate>
+size_t EraseIf(Vector<T, Alloc, Growth, Stats>& v, Predicate pred) {
+    const typename Vector<T, Alloc, Growth, Stats>::MutationScope scope(v);
+    T* const begin = v.Data();
+    T* const end = v.Data() + v.Size();
+    T* read = std::find_if(begin, end, pred);
+    if (read == end) {
+        return 0;
+    }
+    T* write = read;
+    if constexpr (is_trivially_relocatable_v<T>) {
+        //    ,       ,
+        //    ,      .
+        //  *read     find_if,      
+        std::destroy_at(read);
+        try {
+            for (++read; read != end; ++read) {
+                if (pred(*read)) {
+                    std::destroy_at(read);
+                }
+                else {
+                    UninitializedRelocateN(read, 1, write++);
+                }
+            }
+        }
+        catch (...) {
+            //   :  ,     
+            std::memmove(static_cast<void*>(write), static_cast<const void*>(read), (end - read) * sizeof(T));
+            v.size_ -= read - write;
+            throw;
+        }
+    }
+    else {
+        for (++read; read != end; ++read) {
+            if (!pred(*read)) {
+                *write++ = std::move(*read);
+            }
+        }
+        std::destroy(write, end);
+    }
+    const size_t removed = end - write;
+    v.size_ -= removed;
+    v.MaybeShrink();
+    return removed;
+}
+
+//   ,  value,    
+template <typename T, typename Alloc, typename Growth, typename Stats, typename U>
+size_t Erase(Vector<T, Alloc, Growth, Stats>& v, const U& value) {
+    return EraseIf(v, [&value](const T& elem) {
+        return elem == value;
+    });
+}
\ No newline at end of file
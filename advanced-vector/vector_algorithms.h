@@ -0,0 +1,216 @@
+#pragma once
+#include "vector.h"
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+//       .
+//         ,  
+//    SIMD-.  x86-64      AVX-512,
+// AVX2   SSE2,         
+// (target_clones).  AArch64 NEON        .
+// ThreadSanitizer    ifunc-   ,   
+//    
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__) && !defined(__SANITIZE_THREAD__)
+#define VECTOR_SIMD_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define VECTOR_SIMD_CLONES
+#endif
+
+namespace simd {
+
+    //   :  512-   T.  
+    //      ,      
+    //     (     )
+    template <typename T>
+    inline constexpr size_t LANES = 64 / sizeof(T) > 0 ? 64 / sizeof(T) : 1;
+
+    //  ,       
+    inline constexpr size_t BLOCK_SIZE = 64;
+
+    //  :    64 ,        
+    template <typename T>
+    using SumType = std::conditional_t<std::is_floating_point_v<T>, T,
+                                       std::conditional_t<std::is_signed_v<T>, long long, unsigned long long>>;
+
+    template <typename T>
+    VECTOR_SIMD_CLONES const T* Find(const T* first, const T* last, T value) noexcept {
+        while (static_cast<size_t>(last - first) >= BLOCK_SIZE) {
+            //    ,   ""
+            size_t matches = 0;
+            for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+                matches += first[i] == value;
+            }
+            if (matches != 0) {
+                break;
+            }
+            first += BLOCK_SIZE;
+        }
+        for (; first != last; ++first) {
+            if (*first == value) {
+                return first;
+            }
+        }
+        return last;
+    }
+
+    template <typename T>
+    VECTOR_SIMD_CLONES size_t Count(const T* first, const T* last, T value) noexcept {
+        size_t count = 0;
+        for (; first != last; ++first) {
+            count += *first == value;
+        }
+        return count;
+    }
+
+    template <typename T>
+    VECTOR_SIMD_CLONES SumType<T> Sum(const T* first, const T* last) noexcept {
+        SumType<T> lanes[LANES<T>] = {};
+        const size_t count = last - first;
+        const size_t full = count / LANES<T> * LANES<T>;
+        for (size_t i = 0; i < full; i += LANES<T>) {
+            for (size_t k = 0; k < LANES<T>; ++k) {
+                lanes[k] += first[i + k];
+            }
+        }
+        for (size_t i = full; i < count; ++i) {
+            lanes[i - full] += first[i];
+        }
+        SumType<T> sum = 0;
+        for (size_t k = 0; k < LANES<T>; ++k) {
+            sum += lanes[k];
+        }
+        return sum;
+    }
+
+    //   count  a  b
+    template <typename T>
+    VECTOR_SIMD_CLONES SumType<T> Dot(const T* a, const T* b, size_t count) noexcept {
+        SumType<T> lanes[LANES<T>] = {};
+        const size_t full = count / LANES<T> * LANES<T>;
+        for (size_t i = 0; i < full; i += LANES<T>) {
+            for (size_t k = 0; k < LANES<T>; ++k) {
+                lanes[k] += static_cast<SumType<T>>(a[i + k]) * b[i + k];
+            }
+        }
+        for (size_t i = full; i < count; ++i) {
+            lanes[i - full] += static_cast<SumType<T>>(a[i]) * b[i];
+        }
+        SumType<T> sum = 0;
+        for (size_t k = 0; k < LANES<T>; ++k) {
+            sum += lanes[k];
+        }
+        return sum;
+    }
+
+    //      . NaN ,    
+    template <typename T>
+    VECTOR_SIMD_CLONES std::pair<T, T> MinMax(const T* first, const T* last) noexcept {
+        assert(first != last);
+        T min = *first;
+        T max = *first;
+        for (; first != last; ++first) {
+            min = *first < min ? *first : min;
+            max = max < *first ? *first : max;
+        }
+        return { min, max };
+    }
+
+    template <typename T>
+    VECTOR_SIMD_CLONES void Fill(T* first, T* last, T value) noexcept {
+        for (; first != last; ++first) {
+            *first = value;
+        }
+    }
+
+    //  op(src[i])  dst[i]. dst    src
+    template <typename T, typename U, typename UnaryOp>
+    VECTOR_SIMD_CLONES void Transform(const T* src, size_t count, U* dst, UnaryOp op) {
+        for (size_t i = 0; i < count; ++i) {
+            dst[i] = op(src[i]);
+        }
+    }
+
+    //    ==,  -0.0  0.0,  NaN   
+    template <typename T>
+    VECTOR_SIMD_CLONES bool Equal(const T* a, const T* b, size_t count) noexcept {
+        size_t i = 0;
+        for (; i + BLOCK_SIZE <= count; i += BLOCK_SIZE) {
+            size_t matches = 0;
+            for (size_t k = 0; k < BLOCK_SIZE; ++k) {
+                matches += a[i + k] == b[i + k];
+            }
+            if (matches != BLOCK_SIZE) {
+                return false;
+            }
+        }
+        for (; i < count; ++i) {
+            if (!(a[i] == b[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+}  // namespace simd
+
+template <typename T, typename Alloc, typename Growth, typename Stats>
+const T* Find(const Vector<T, Alloc, Growth, Stats>& v, T value) noexcept {
+    static_assert(std::is_arithmetic_v<T>);
+    return simd::Find(v.Data(), v.Data() + v.Size(), value);
+}
+
+template <typename T, typename Alloc, typename Growth, typename Stats>
+size_t Count(const Vector<T, Alloc, Growth, Stats>& v, T value) noexcept {
+    static_assert(std::is_arithmetic_v<T>);
+    return simd::Count(v.Data(), v.Data() + v.Size(), value);
+}
+
+template <typename T, typename Alloc, typename Growth, typename Stats>
+simd::SumType<T> Sum(const Vector<T, Alloc, Growth, Stats>& v) noexcept {
+    static_assert(std::is_arithmetic_v<T>);
+    return simd::Sum(v.Data(), v.Data() + v.Size());
+}
+
+template <typename T, typename A1, typename G1, typename S1, typename A2, typename G2, typename S2>
+simd::SumType<T> Dot(const Vector<T, A1, G1, S1>& a, const Vector<T, A2, G2, S2>& b) noexcept {
+    static_assert(std::is_arithmetic_v<T>);
+    assert(a.Size() == b.Size());
+    return simd::Dot(a.Data(), b.Data(), a.Size());
+}
+
+template <typename T, typename Alloc, typename Growth, typename Stats>
+std::pair<T, T> MinMax(const Vector<T, Alloc, Growth, Stats>& v) noexcept {
+    static_assert(std::is_arithmetic_v<T>);
+    return simd::MinMax(v.Data(), v.Data() + v.Size());
+}
+
+template <typename T, typename Alloc, typename Growth, typename Stats>
+void Fill(Vector<T, Alloc, Growth, Stats>& v, T value) noexcept {
+    static_assert(std::is_arithmetic_v<T>);
+    simd::Fill(v.Data(), v.Data() + v.Size(), value);
+}
+
+//    v  op()
+template <typename T, typename Alloc, typename Growth, typename Stats, typename UnaryOp>
+void Transform(Vector<T, Alloc, Growth, Stats>& v, UnaryOp op) {
+    static_assert(std::is_arithmetic_v<T>);
+    simd::Transform(v.Data(), v.Size(), v.Data(), op);
+}
+
+//   dst  op   src.   dst 
+template <typename T, typename A1, typename G1, typename S1, typename U, typename A2, typename G2, typename S2,
+          typename UnaryOp>
+void Transform(const Vector<T, A1, G1, S1>& src, Vector<U, A2, G2, S2>& dst, UnaryOp op) {
+    static_assert(std::is_arithmetic_v<T> && std::is_arithmetic_v<U>);
+    dst.ResizeDefaultInit(src.Size());
+    simd::Transform(src.Data(), src.Size(), dst.Data(), op);
+}
+
+template <typename T, typename A1, typename G1, typename S1, typename A2, typename G2, typename S2>
+bool Equal(const Vector<T, A1, G1, S1>& a, const Vector<T, A2, G2, S2>& b) noexcept {
+    static_assert(std::is_arithmetic_v<T>);
+    return a.Size() == b.Size() && simd::Equal(a.Data(), b.Data(), a.Size());
+}
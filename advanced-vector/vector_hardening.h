@@ -0,0 +1,226 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <type_traits>
+
+//     -DVECTOR_HARDENED=1:
+//   - operator[]    RawMemory      
+//      ,     assert   ;
+//   -  Vector - CheckedIterator:    ,   
+//      ,      ,  ;
+//   -  AddressSanitizer    ,    Size()  
+//      ASan   container-overflow.
+//    -  ,  - assert,      .
+//  ,   ,      
+#ifndef VECTOR_HARDENED
+#define VECTOR_HARDENED 0
+#endif
+
+#if defined(__SANITIZE_ADDRESS__)
+#define VECTOR_HAS_ASAN 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define VECTOR_HAS_ASAN 1
+#endif
+#endif
+#ifndef VECTOR_HAS_ASAN
+#define VECTOR_HAS_ASAN 0
+#endif
+
+//  ASan      ,  VECTOR_ANNOTATE_CONTAINER=1
+#ifndef VECTOR_ANNOTATE_CONTAINER
+#define VECTOR_ANNOTATE_CONTAINER (VECTOR_HARDENED && VECTOR_HAS_ASAN)
+#endif
+
+#if VECTOR_ANNOTATE_CONTAINER
+#include <sanitizer/common_interface_defs.h>
+#endif
+
+//         
+[[noreturn]] inline void HardeningFailure(const char* what) noexcept {
+    std::fprintf(stderr, "Vector hardening check failed: %s\n", what);
+    std::abort();
+}
+
+#if VECTOR_HARDENED
+#define VECTOR_CHECK(condition, message) ((condition) ? void(0) : HardeningFailure(message))
+#else
+#define VECTOR_CHECK(condition, message) assert((condition) && (message))
+#endif
+
+//  ASan,     [first, last)   [first, old_mid)  [first, new_mid).
+// ASan     8 ,      ,
+//  ,      ,  
+inline void AnnotateContiguousContainer([[maybe_unused]] const void* first, [[maybe_unused]] const void* last,
+                                        [[maybe_unused]] const void* old_mid,
+                                        [[maybe_unused]] const void* new_mid) noexcept {
+#if VECTOR_ANNOTATE_CONTAINER
+    constexpr uintptr_t GRANULE = 8;
+    const auto begin = reinterpret_cast<uintptr_t>(first);
+    const uintptr_t end = reinterpret_cast<uintptr_t>(last) / GRANULE * GRANULE;
+    if (begin % GRANULE != 0 || end <= begin) {
+        return;
+    }
+    const auto clamp = [end](const void* mid) {
+        return reinterpret_cast<const void*>(std::min(reinterpret_cast<uintptr_t>(mid), end));
+    };
+    __sanitizer_annotate_contiguous_container(first, reinterpret_cast<const void*>(end), clamp(old_mid),
+                                              clamp(new_mid));
+#endif
+}
+
+//   :   ,       
+//  .  ,         ,
+//    -         .
+//  Owner  CheckedIterator   
+//   Data(), Size()  IteratorGeneration() -   
+template <typename T, typename Owner>
+class CheckedIterator {
+    template <typename, typename>
+    friend class CheckedIterator;
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = std::remove_cv_t<T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T&;
+
+    CheckedIterator() noexcept = default;
+
+    constexpr CheckedIterator(T* ptr, const Owner* owner, size_t generation) noexcept
+        : ptr_(ptr)
+        , owner_(owner)
+        , generation_(generation) {
+    }
+
+    // iterator    const_iterator
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+    constexpr CheckedIterator(const CheckedIterator<U, Owner>& other) noexcept
+        : ptr_(other.ptr_)
+        , owner_(other.owner_)
+        , generation_(other.generation_) {
+    }
+
+    //   , ,    ,  T*
+    constexpr T* Base() const noexcept {
+        return ptr_;
+    }
+
+    constexpr reference operator*() const noexcept {
+        CheckDereferenceable();
+        return *ptr_;
+    }
+
+    constexpr pointer operator->() const noexcept {
+        CheckDereferenceable();
+        return ptr_;
+    }
+
+    constexpr reference operator[](difference_type n) const noexcept {
+        return *(*this + n);
+    }
+
+    constexpr CheckedIterator& operator++() noexcept {
+        ++ptr_;
+        return *this;
+    }
+    constexpr CheckedIterator operator++(int) noexcept {
+        CheckedIterator copy = *this;
+        ++ptr_;
+        return copy;
+    }
+    constexpr CheckedIterator& operator--() noexcept {
+        --ptr_;
+        return *this;
+    }
+    constexpr CheckedIterator operator--(int) noexcept {
+        CheckedIterator copy = *this;
+        --ptr_;
+        return copy;
+    }
+
+    constexpr CheckedIterator& operator+=(difference_type n) noexcept {
+        ptr_ += n;
+        return *this;
+    }
+    constexpr CheckedIterator& operator-=(difference_type n) noexcept {
+        ptr_ -= n;
+        return *this;
+    }
+
+    friend constexpr CheckedIterator operator+(CheckedIterator it, difference_type n) noexcept {
+        return it += n;
+    }
+    friend constexpr CheckedIterator operator+(difference_type n, CheckedIterator it) noexcept {
+        return it += n;
+    }
+    friend constexpr CheckedIterator operator-(CheckedIterator it, difference_type n) noexcept {
+        return it -= n;
+    }
+
+    template <typename U>
+    constexpr difference_type operator-(const CheckedIterator<U, Owner>& other) const noexcept {
+        CheckComparable(other);
+        return ptr_ - other.ptr_;
+    }
+
+    template <typename U>
+    constexpr bool operator==(const CheckedIterator<U, Owner>& other) const noexcept {
+        CheckComparable(other);
+        return ptr_ == other.ptr_;
+    }
+    template <typename U>
+    constexpr bool operator!=(const CheckedIterator<U, Owner>& other) const noexcept {
+        return !(*this == other);
+    }
+    template <typename U>
+    constexpr bool operator<(const CheckedIterator<U, Owner>& other) const noexcept {
+        CheckComparable(other);
+        return ptr_ < other.ptr_;
+    }
+    template <typename U>
+    constexpr bool operator>(const CheckedIterator<U, Owner>& other) const noexcept {
+        return other < *this;
+    }
+    template <typename U>
+    constexpr bool operator<=(const CheckedIterator<U, Owner>& other) const noexcept {
+        return !(other < *this);
+    }
+    template <typename U>
+    constexpr bool operator>=(const CheckedIterator<U, Owner>& other) const noexcept {
+        return !(*this < other);
+    }
+
+private:
+    constexpr void CheckValid() const noexcept {
+        VECTOR_CHECK(owner_ != nullptr, "singular iterator");
+        VECTOR_CHECK(generation_ == owner_->IteratorGeneration(), "iterator invalidated by reallocation");
+    }
+
+    constexpr void CheckDereferenceable() const noexcept {
+        CheckValid();
+        const T* first = owner_->Data();
+        VECTOR_CHECK(first <= ptr_ && ptr_ < first + owner_->Size(), "iterator out of range");
+    }
+
+    template <typename U>
+    constexpr void CheckComparable(const CheckedIterator<U, Owner>& other) const noexcept {
+        if (owner_ == nullptr && other.owner_ == nullptr) {
+            return;
+        }
+        VECTOR_CHECK(owner_ == other.owner_, "iterators of different containers");
+        CheckValid();
+        other.CheckValid();
+    }
+
+    T* ptr_ = nullptr;
+    const Owner* owner_ = nullptr;
+    size_t generation_ = 0;
+};
@@ -0,0 +1,267 @@
+#pragma once
+#include "vector.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+//   Vector.    ,        :
+//   BULK    -    T  ;  ,   ,
+//              -  Reserve   ;
+//   CHUNKED - ,  ,    CHUNK_BYTES .  
+//                   ,    ,
+//                 ,    .
+//          .
+//       :        
+//  ,         
+//  ,   std::runtime_error.
+//
+//   T:
+//   void Encode(const T& value, std::string& out) const -   value  out;
+//   T Decode(std::string_view& in) const                 -     in  
+//                                                          ;    
+//                                                          std::runtime_error
+namespace serialization {
+
+    enum class Format : uint16_t {
+        BULK = 1,
+        CHUNKED = 2,
+    };
+
+    struct Header {
+        uint32_t magic;
+        uint16_t version;
+        Format format;
+        uint32_t elem_size;  // sizeof(T)  BULK, 0  CHUNKED
+        uint32_t reserved;
+        uint64_t count;
+    };
+
+    struct ChunkHeader {
+        uint64_t count;
+        uint64_t bytes;
+    };
+
+    inline constexpr uint32_t MAGIC = 0x56454356;  // "VCEV"
+    inline constexpr uint16_t VERSION = 1;
+    inline constexpr size_t CHUNK_BYTES = 64 * 1024;
+    //       CHUNKED   
+    inline constexpr size_t MAX_RESERVE_BYTES = 1 << 20;
+
+    // ,     T.     
+    template <typename T>
+    struct BytewiseCodec {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        void Encode(const T& value, std::string& out) const {
+            out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        T Decode(std::string_view& in) const {
+            if (in.size() < sizeof(T)) {
+                throw std::runtime_error("Deserialize: truncated element");
+            }
+            T value;
+            std::memcpy(static_cast<void*>(&value), in.data(), sizeof(T));
+            in.remove_prefix(sizeof(T));
+            return value;
+        }
+    };
+
+    //    64-   
+    struct StringCodec {
+        void Encode(const std::string& value, std::string& out) const {
+            BytewiseCodec<uint64_t>().Encode(value.size(), out);
+            out += value;
+        }
+
+        std::string Decode(std::string_view& in) const {
+            const uint64_t size = BytewiseCodec<uint64_t>().Decode(in);
+            if (in.size() < size) {
+                throw std::runtime_error("Deserialize: truncated element");
+            }
+            std::string value(in.substr(0, size));
+            in.remove_prefix(size);
+            return value;
+        }
+    };
+
+    inline void WriteBytes(std::ostream& out, const void* data, size_t bytes) {
+        out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+        if (!out) {
+            throw std::runtime_error("Serialize: write failed");
+        }
+    }
+
+    inline void ReadBytes(std::istream& in, void* data, size_t bytes) {
+        in.read(static_cast<char*>(data), static_cast<std::streamsize>(bytes));
+        if (static_cast<size_t>(in.gcount()) != bytes) {
+            throw std::runtime_error("Deserialize: unexpected end of stream");
+        }
+    }
+
+    //       -1,     
+    inline std::streamoff RemainingBytes(std::istream& in) {
+        const std::streampos pos = in.tellg();
+        if (pos == std::streampos(-1)) {
+            return -1;
+        }
+        in.seekg(0, std::ios::end);
+        const std::streampos end = in.tellg();
+        in.clear();
+        in.seekg(pos);
+        return end == std::streampos(-1) ? -1 : static_cast<std::streamoff>(end - pos);
+    }
+
+    //  count   elem_size . grow(n)    n  
+    //    .     ,    
+    //     .        ,
+    //         
+    template <typename Grow>
+    void ReadGrowing(std::istream& in, uint64_t count, size_t elem_size, Grow grow) {
+        const std::streamoff remaining = RemainingBytes(in);
+        if (remaining >= 0 && count > static_cast<uint64_t>(remaining) / elem_size) {
+            throw std::runtime_error("Deserialize: unexpected end of stream");
+        }
+        uint64_t step = remaining >= 0 ? count : std::max<uint64_t>(1, CHUNK_BYTES / elem_size);
+        uint64_t done = 0;
+        while (done < count) {
+            const uint64_t n = std::min(step, count - done);
+            char* data = grow(static_cast<size_t>(done + n));
+            ReadBytes(in, data + done * elem_size, static_cast<size_t>(n * elem_size));
+            done += n;
+            step *= 2;
+        }
+    }
+
+    inline Header ReadHeader(std::istream& in, Format format, uint32_t elem_size) {
+        Header header{};
+        ReadBytes(in, &header, sizeof(header));
+        if (header.magic != MAGIC || header.version != VERSION) {
+            throw std::runtime_error("Deserialize: not a serialized Vector");
+        }
+        if (header.format != format || header.elem_size != elem_size) {
+            throw std::runtime_error("Deserialize: stream format does not match the element type");
+        }
+        return header;
+    }
+
+    //         
+    template <typename Alloc>
+    void CheckCount(uint64_t count, const Alloc& alloc) {
+        if (count > std::allocator_traits<Alloc>::max_size(alloc)) {
+            throw std::runtime_error("Deserialize: element count is too large");
+        }
+    }
+
+    //   :     ,      
+    template <typename T, typename Codec>
+    void WriteChunked(std::ostream& out, const T* first, size_t count, const Codec& codec) {
+        const Header header{ MAGIC, VERSION, Format::CHUNKED, 0, 0, count };
+        WriteBytes(out, &header, sizeof(header));
+        std::string buffer;
+        buffer.reserve(CHUNK_BYTES);
+        uint64_t chunk_count = 0;
+        const auto flush = [&] {
+            const ChunkHeader chunk{ chunk_count, buffer.size() };
+            WriteBytes(out, &chunk, sizeof(chunk));
+            WriteBytes(out, buffer.data(), buffer.size());
+            buffer.clear();
+            chunk_count = 0;
+        };
+        for (size_t i = 0; i < count; ++i) {
+            codec.Encode(first[i], buffer);
+            ++chunk_count;
+            if (buffer.size() >= CHUNK_BYTES) {
+                flush();
+            }
+        }
+        if (chunk_count != 0) {
+            flush();
+        }
+    }
+
+}  // namespace serialization
+
+//     v  
+template <typename T, typename Alloc, typename Growth, typename Stats>
+void Serialize(std::ostream& out, const Vector<T, Alloc, Growth, Stats>& v) {
+    static_assert(std::is_trivially_copyable_v<T>, "Serialize without a codec needs trivially copyable T");
+    using namespace serialization;
+    const Header header{ MAGIC, VERSION, Format::BULK, sizeof(T), 0, v.Size() };
+    WriteBytes(out, &header, sizeof(header));
+    WriteBytes(out, v.Data(), v.Size() * sizeof(T));
+}
+
+//   v,  codec, 
+template <typename T, typename Alloc, typename Growth, typename Stats, typename Codec>
+void Serialize(std::ostream& out, const Vector<T, Alloc, Growth, Stats>& v, const Codec& codec) {
+    serialization::WriteChunked(out, v.Data(), v.Size(), codec);
+}
+
+//   v ,  Serialize  .    ,
+//        .  ,      
+//     ,  std::runtime_error   v 
+template <typename T, typename Alloc, typename Growth, typename Stats>
+void Deserialize(std::istream& in, Vector<T, Alloc, Growth, Stats>& v) {
+    static_assert(std::is_trivially_copyable_v<T>, "Deserialize without a codec needs trivially copyable T");
+    using namespace serialization;
+    v.Clear();
+    const Header header = ReadHeader(in, Format::BULK, sizeof(T));
+    CheckCount(header.count, v.GetAllocator());
+    try {
+        ReadGrowing(in, header.count, sizeof(T), [&v](size_t size) {
+            v.ResizeDefaultInit(size);
+            return reinterpret_cast<char*>(v.Data());
+        });
+    }
+    catch (...) {
+        v.Clear();
+        throw;
+    }
+}
+
+//   v ,  Serialize  .    
+//      .    std::runtime_error   v 
+template <typename T, typename Alloc, typename Growth, typename Stats, typename Codec>
+void Deserialize(std::istream& in, Vector<T, Alloc, Growth, Stats>& v, const Codec& codec) {
+    using namespace serialization;
+    v.Clear();
+    const Header header = ReadHeader(in, Format::CHUNKED, 0);
+    CheckCount(header.count, v.GetAllocator());
+    try {
+        v.Reserve(std::min<uint64_t>(header.count, MAX_RESERVE_BYTES / sizeof(T)));
+        std::string buffer;
+        while (v.Size() < header.count) {
+            ChunkHeader chunk{};
+            ReadBytes(in, &chunk, sizeof(chunk));
+            if (chunk.count == 0 || chunk.count > header.count - v.Size()) {
+                throw std::runtime_error("Deserialize: corrupted chunk");
+            }
+            buffer.clear();
+            ReadGrowing(in, chunk.bytes, 1, [&buffer](size_t size) {
+                buffer.resize(size);
+                return buffer.data();
+            });
+            std::string_view bytes(buffer);
+            for (uint64_t i = 0; i < chunk.count; ++i) {
+                v.EmplaceBack(codec.Decode(bytes));
+            }
+            if (!bytes.empty()) {
+                throw std::runtime_error("Deserialize: corrupted chunk");
+            }
+        }
+    }
+    catch (...) {
+        v.Clear();
+        throw;
+    }
+}
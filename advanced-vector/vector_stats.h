@@ -0,0 +1,278 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// ,        
+enum class RelocationKind {
+    BYTEWISE,  //   , memcpy    
+    MOVED,     //  
+    COPIED,    //   (   )
+};
+
+//    
+struct VectorStats {
+    size_t allocations = 0;         //  ,    Grow
+    size_t bytes_allocated = 0;     //    
+    size_t reallocations = 0;       //  ,     
+    size_t relocated_bytewise = 0;  // ,  
+    size_t relocated_moved = 0;     // ,  
+    size_t relocated_copied = 0;    // ,  
+    size_t peak_capacity = 0;       //  
+    size_t final_sizes = 0;         //   ,     typical_final_size
+    size_t typical_final_size = 0;  //     , . SharedStats::OnFinalSize
+};
+
+inline std::ostream& operator<<(std::ostream& out, const VectorStats& stats) {
+    return out << "allocations=" << stats.allocations
+               << " bytes_allocated=" << stats.bytes_allocated
+               << " reallocations=" << stats.reallocations
+               << " relocated_bytewise=" << stats.relocated_bytewise
+               << " relocated_moved=" << stats.relocated_moved
+               << " relocated_copied=" << stats.relocated_copied
+               << " peak_capacity=" << stats.peak_capacity
+               << " final_sizes=" << stats.final_sizes
+               << " typical_final_size=" << stats.typical_final_size;
+}
+
+//   Vector  :
+//   OnAllocate(capacity, bytes) -     capacity;
+//   OnReallocate()              -      ;
+//   OnRelocate(count, kind)     - count    kind.
+//  ,    :
+//   OnFinalSize(size)           -    size  ;
+//   size_t CapacityHint()       - ,       
+//                                       (0 -  ).
+// NoStats          ,  
+struct NoStats {
+    constexpr void OnAllocate(size_t /*capacity*/, size_t /*bytes*/) noexcept {
+    }
+    constexpr void OnReallocate() noexcept {
+    }
+    constexpr void OnRelocate(size_t /*count*/, RelocationKind /*kind*/) noexcept {
+    }
+};
+
+template <typename Stats, typename = void>
+struct has_on_final_size : std::false_type {};
+
+template <typename Stats>
+struct has_on_final_size<Stats, std::void_t<decltype(std::declval<Stats&>().OnFinalSize(size_t{}))>>
+    : std::true_type {};
+
+template <typename Stats>
+inline constexpr bool has_on_final_size_v = has_on_final_size<Stats>::value;
+
+template <typename Stats, typename = void>
+struct has_capacity_hint : std::false_type {};
+
+template <typename Stats>
+struct has_capacity_hint<Stats, std::void_t<decltype(size_t{ std::declval<const Stats&>().CapacityHint() })>>
+    : std::true_type {};
+
+template <typename Stats>
+inline constexpr bool has_capacity_hint_v = has_capacity_hint<Stats>::value;
+
+// ,     .    
+//   ,       
+class InstanceStats {
+public:
+    InstanceStats() = default;
+    InstanceStats(const InstanceStats& /*other*/) noexcept {
+    }
+    InstanceStats& operator=(const InstanceStats& /*other*/) noexcept {
+        return *this;
+    }
+
+    void OnAllocate(size_t capacity, size_t bytes) noexcept {
+        ++stats_.allocations;
+        stats_.bytes_allocated += bytes;
+        stats_.peak_capacity = std::max(stats_.peak_capacity, capacity);
+    }
+    void OnReallocate() noexcept {
+        ++stats_.reallocations;
+    }
+    void OnRelocate(size_t count, RelocationKind kind) noexcept {
+        switch (kind) {
+        case RelocationKind::BYTEWISE:
+            stats_.relocated_bytewise += count;
+            break;
+        case RelocationKind::MOVED:
+            stats_.relocated_moved += count;
+            break;
+        case RelocationKind::COPIED:
+            stats_.relocated_copied += count;
+            break;
+        }
+    }
+
+    const VectorStats& Get() const noexcept {
+        return stats_;
+    }
+
+private:
+    VectorStats stats_;
+};
+
+//     .  ,     
+//     
+class SharedStats {
+public:
+    void OnAllocate(size_t capacity, size_t bytes) noexcept {
+        allocations_.fetch_add(1, std::memory_order_relaxed);
+        bytes_allocated_.fetch_add(bytes, std::memory_order_relaxed);
+        size_t peak = peak_capacity_.load(std::memory_order_relaxed);
+        while (peak < capacity && !peak_capacity_.compare_exchange_weak(peak, capacity, std::memory_order_relaxed)) {
+        }
+    }
+    void OnReallocate() noexcept {
+        reallocations_.fetch_add(1, std::memory_order_relaxed);
+    }
+    void OnRelocate(size_t count, RelocationKind kind) noexcept {
+        switch (kind) {
+        case RelocationKind::BYTEWISE:
+            relocated_bytewise_.fetch_add(count, std::memory_order_relaxed);
+            break;
+        case RelocationKind::MOVED:
+            relocated_moved_.fetch_add(count, std::memory_order_relaxed);
+            break;
+        case RelocationKind::COPIED:
+            relocated_copied_.fetch_add(count, std::memory_order_relaxed);
+            break;
+        }
+    }
+
+    //   -      1/8   .
+    //    :      ,   
+    void OnFinalSize(size_t size) noexcept {
+        final_sizes_.fetch_add(1, std::memory_order_relaxed);
+        size_t typical = typical_final_size_.load(std::memory_order_relaxed);
+        size_t next = 0;
+        do {
+            if (typical == 0) {
+                next = size;
+            }
+            else if (size > typical) {
+                next = typical + (size - typical + 7) / 8;
+            }
+            else {
+                next = typical - (typical - size) / 8;
+            }
+        } while (!typical_final_size_.compare_exchange_weak(typical, next, std::memory_order_relaxed));
+    }
+
+    size_t TypicalFinalSize() const noexcept {
+        return typical_final_size_.load(std::memory_order_relaxed);
+    }
+
+    VectorStats Get() const noexcept {
+        VectorStats stats;
+        stats.allocations = allocations_.load(std::memory_order_relaxed);
+        stats.bytes_allocated = bytes_allocated_.load(std::memory_order_relaxed);
+        stats.reallocations = reallocations_.load(std::memory_order_relaxed);
+        stats.relocated_bytewise = relocated_bytewise_.load(std::memory_order_relaxed);
+        stats.relocated_moved = relocated_moved_.load(std::memory_order_relaxed);
+        stats.relocated_copied = relocated_copied_.load(std::memory_order_relaxed);
+        stats.peak_capacity = peak_capacity_.load(std::memory_order_relaxed);
+        stats.final_sizes = final_sizes_.load(std::memory_order_relaxed);
+        stats.typical_final_size = typical_final_size_.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    std::atomic<size_t> allocations_{ 0 };
+    std::atomic<size_t> bytes_allocated_{ 0 };
+    std::atomic<size_t> reallocations_{ 0 };
+    std::atomic<size_t> relocated_bytewise_{ 0 };
+    std::atomic<size_t> relocated_moved_{ 0 };
+    std::atomic<size_t> relocated_copied_{ 0 };
+    std::atomic<size_t> peak_capacity_{ 0 };
+    std::atomic<size_t> final_sizes_{ 0 };
+    std::atomic<size_t> typical_final_size_{ 0 };
+};
+
+//    ,     
+class StatsRegistry {
+public:
+    struct Entry {
+        std::string_view name;
+        const SharedStats* stats;
+    };
+
+    static void Add(std::string_view name, const SharedStats& stats) {
+        auto& instance = Instance();
+        std::lock_guard guard(instance.mutex_);
+        instance.entries_.push_back({ name, &stats });
+    }
+
+    static std::vector<Entry> Entries() {
+        auto& instance = Instance();
+        std::lock_guard guard(instance.mutex_);
+        return instance.entries_;
+    }
+
+    //     : "<> allocations=... peak_capacity=..."
+    static void Export(std::ostream& out) {
+        for (const Entry& entry : Entries()) {
+            out << entry.name << ' ' << entry.stats->Get() << '\n';
+        }
+    }
+
+private:
+    static StatsRegistry& Instance() {
+        static StatsRegistry registry;
+        return registry;
+    }
+
+    std::mutex mutex_;
+    std::vector<Entry> entries_;
+};
+
+// ,       Tag (,     ).
+// Tag   static constexpr std::string_view NAME.    
+template <typename Tag>
+class TaggedStats {
+public:
+    void OnAllocate(size_t capacity, size_t bytes) noexcept {
+        Shared().OnAllocate(capacity, bytes);
+    }
+    void OnReallocate() noexcept {
+        Shared().OnReallocate();
+    }
+    void OnRelocate(size_t count, RelocationKind kind) noexcept {
+        Shared().OnRelocate(count, kind);
+    }
+    void OnFinalSize(size_t size) noexcept {
+        Shared().OnFinalSize(size);
+    }
+
+    static VectorStats Get() noexcept {
+        return Shared().Get();
+    }
+
+protected:
+    static SharedStats& Shared() noexcept {
+        static SharedStats stats;
+        static const bool registered = (StatsRegistry::Add(Tag::NAME, stats), true);
+        (void)registered;
+        return stats;
+    }
+};
+
+// TaggedStats,     :    Tag  ,
+//       ,          
+//     .      ,
+//  Reserve       
+template <typename Tag>
+class HintedStats : public TaggedStats<Tag> {
+public:
+    static size_t CapacityHint() noexcept {
+        return TaggedStats<Tag>::Shared().TypicalFinalSize();
+    }
+};